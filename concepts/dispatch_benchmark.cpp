@@ -0,0 +1,306 @@
+#include <algorithm>
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <concepts>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+// Three ways of dispatching the same operation (move + bounding box) over a collection:
+//  - virtual functions (Shapes::Shape style), with and without `final` classes - `final` lets the compiler
+//    devirtualize only when the static type is the final class, calls through Shape* are unaffected
+//  - concept-constrained templates (render<Shape T> style) - static dispatch, needs one container per type
+//  - closed set of types in std::variant + std::visit
+
+namespace dispatch
+{
+    struct BoundingBox
+    {
+        int w, h;
+    };
+
+    namespace virtual_shapes
+    {
+        class Shape
+        {
+        public:
+            virtual ~Shape() = default;
+            virtual void move(int dx, int dy) = 0;
+            virtual BoundingBox box() const noexcept = 0;
+        };
+
+        class Rect : public Shape
+        {
+            int x_ = 0, y_ = 0, w_, h_;
+
+        public:
+            Rect(int w, int h)
+                : w_{w}
+                , h_{h}
+            { }
+
+            void move(int dx, int dy) override
+            {
+                x_ += dx;
+                y_ += dy;
+            }
+
+            BoundingBox box() const noexcept override
+            {
+                return BoundingBox{w_, h_};
+            }
+        };
+
+        class Square : public Shape
+        {
+            int x_ = 0, y_ = 0, size_;
+
+        public:
+            explicit Square(int size)
+                : size_{size}
+            { }
+
+            void move(int dx, int dy) override
+            {
+                x_ += dx;
+                y_ += dy;
+            }
+
+            BoundingBox box() const noexcept override
+            {
+                return BoundingBox{size_, size_};
+            }
+        };
+
+        class RectFinal final : public Rect
+        {
+        public:
+            using Rect::Rect;
+        };
+
+        class SquareFinal final : public Square
+        {
+        public:
+            using Square::Square;
+        };
+    } // namespace virtual_shapes
+
+    namespace value_shapes
+    {
+        struct Rect
+        {
+            int x = 0, y = 0, w, h;
+
+            void move(int dx, int dy) noexcept
+            {
+                x += dx;
+                y += dy;
+            }
+
+            BoundingBox box() const noexcept
+            {
+                return BoundingBox{w, h};
+            }
+        };
+
+        struct Square
+        {
+            int x = 0, y = 0, size;
+
+            void move(int dx, int dy) noexcept
+            {
+                x += dx;
+                y += dy;
+            }
+
+            BoundingBox box() const noexcept
+            {
+                return BoundingBox{size, size};
+            }
+        };
+
+        using ShapeVariant = std::variant<Rect, Square>;
+    } // namespace value_shapes
+
+    // clang-format off
+    template <typename T>
+    concept Shape = requires(T& obj)
+    {
+        { obj.box() } noexcept -> std::same_as<BoundingBox>;
+        obj.move(1, 1);
+    };
+    // clang-format on
+
+    template <Shape T>
+    long render(T& shp)
+    {
+        shp.move(1, 1);
+        auto [w, h] = shp.box();
+        return w * h;
+    }
+
+    long render(virtual_shapes::Shape& shp)
+    {
+        shp.move(1, 1);
+        auto [w, h] = shp.box();
+        return w * h;
+    }
+
+    long render(value_shapes::ShapeVariant& shp)
+    {
+        return std::visit([](auto& s) { return render(s); }, shp);
+    }
+
+    template <typename Container>
+    long render_all(Container& shapes)
+    {
+        long total = 0;
+        for (auto& shp : shapes)
+        {
+            if constexpr (requires { *shp; })
+                total += render(*shp);
+            else
+                total += render(shp);
+        }
+        return total;
+    }
+
+    template <typename... Containers>
+    long render_all(std::tuple<Containers...>& buckets)
+    {
+        return std::apply([](auto&... bucket) { return (0L + ... + render_all(bucket)); }, buckets);
+    }
+
+    enum class Kind : char
+    {
+        rect,
+        square
+    };
+
+    // Describes the collection: kind of the i-th object
+    std::vector<Kind> make_layout(std::size_t count, bool heterogeneous)
+    {
+        std::vector<Kind> layout(count, Kind::rect);
+        if (heterogeneous)
+        {
+            std::fill(layout.begin(), layout.begin() + count / 2, Kind::square);
+            std::ranges::shuffle(layout, std::mt19937{42});
+        }
+        return layout;
+    }
+
+    int size_of(std::size_t index)
+    {
+        return static_cast<int>(index % 16) + 1;
+    }
+
+    template <typename TRect, typename TSquare>
+    std::vector<std::unique_ptr<virtual_shapes::Shape>> make_virtual(const std::vector<Kind>& layout)
+    {
+        std::vector<std::unique_ptr<virtual_shapes::Shape>> shapes;
+        shapes.reserve(layout.size());
+        for (std::size_t i = 0; i < layout.size(); ++i)
+        {
+            if (layout[i] == Kind::square)
+                shapes.push_back(std::make_unique<TSquare>(size_of(i)));
+            else
+                shapes.push_back(std::make_unique<TRect>(size_of(i), size_of(i) + 1));
+        }
+        return shapes;
+    }
+
+    std::vector<value_shapes::ShapeVariant> make_variant(const std::vector<Kind>& layout)
+    {
+        std::vector<value_shapes::ShapeVariant> shapes;
+        shapes.reserve(layout.size());
+        for (std::size_t i = 0; i < layout.size(); ++i)
+        {
+            if (layout[i] == Kind::square)
+                shapes.push_back(value_shapes::Square{.size = size_of(i)});
+            else
+                shapes.push_back(value_shapes::Rect{.w = size_of(i), .h = size_of(i) + 1});
+        }
+        return shapes;
+    }
+
+    std::tuple<std::vector<value_shapes::Rect>, std::vector<value_shapes::Square>> make_buckets(const std::vector<Kind>& layout)
+    {
+        std::tuple<std::vector<value_shapes::Rect>, std::vector<value_shapes::Square>> buckets;
+        for (std::size_t i = 0; i < layout.size(); ++i)
+        {
+            if (layout[i] == Kind::square)
+                std::get<1>(buckets).push_back(value_shapes::Square{.size = size_of(i)});
+            else
+                std::get<0>(buckets).push_back(value_shapes::Rect{.w = size_of(i), .h = size_of(i) + 1});
+        }
+        return buckets;
+    }
+} // namespace dispatch
+
+TEST_CASE("dispatch styles compute the same result")
+{
+    using namespace dispatch;
+
+    for (bool heterogeneous : {false, true})
+    {
+        const auto layout = make_layout(1'000, heterogeneous);
+
+        auto virtual_shapes = make_virtual<virtual_shapes::Rect, virtual_shapes::Square>(layout);
+        auto final_shapes = make_virtual<virtual_shapes::RectFinal, virtual_shapes::SquareFinal>(layout);
+        auto variant_shapes = make_variant(layout);
+        auto buckets = make_buckets(layout);
+
+        const long expected = render_all(virtual_shapes);
+        CHECK(render_all(final_shapes) == expected);
+        CHECK(render_all(variant_shapes) == expected);
+        CHECK(render_all(buckets) == expected);
+    }
+}
+
+TEST_CASE("dispatch benchmark - virtual vs concepts vs variant", "[.benchmark]")
+{
+    using namespace dispatch;
+    namespace bm = helpers::benchmark;
+
+    constexpr std::size_t count = 1 << 16;
+
+    SECTION("homogeneous collection")
+    {
+        const auto layout = make_layout(count, false);
+
+        auto virtual_shapes = make_virtual<virtual_shapes::Rect, virtual_shapes::Square>(layout);
+        bm::run("homogeneous: virtual Shape*", count, [&] { bm::do_not_optimize(render_all(virtual_shapes)); });
+
+        std::vector<std::unique_ptr<virtual_shapes::Rect>> rects;
+        std::vector<std::unique_ptr<virtual_shapes::RectFinal>> final_rects;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            rects.push_back(std::make_unique<virtual_shapes::Rect>(size_of(i), size_of(i) + 1));
+            final_rects.push_back(std::make_unique<virtual_shapes::RectFinal>(size_of(i), size_of(i) + 1));
+        }
+        bm::run("homogeneous: virtual Rect* (non-final)", count, [&] { bm::do_not_optimize(render_all(rects)); });
+        bm::run("homogeneous: virtual RectFinal* (final)", count, [&] { bm::do_not_optimize(render_all(final_rects)); });
+
+        auto buckets = make_buckets(layout);
+        bm::run("homogeneous: render<Shape T> by value", count, [&] { bm::do_not_optimize(render_all(buckets)); });
+
+        auto variant_shapes = make_variant(layout);
+        bm::run("homogeneous: std::variant + std::visit", count, [&] { bm::do_not_optimize(render_all(variant_shapes)); });
+    }
+
+    SECTION("shuffled heterogeneous collection")
+    {
+        const auto layout = make_layout(count, true);
+
+        auto virtual_shapes = make_virtual<virtual_shapes::Rect, virtual_shapes::Square>(layout);
+        bm::run("shuffled: virtual Shape*", count, [&] { bm::do_not_optimize(render_all(virtual_shapes)); });
+
+        auto buckets = make_buckets(layout); // order is not preserved - one container per type
+        bm::run("shuffled: render<Shape T> per-type buckets", count, [&] { bm::do_not_optimize(render_all(buckets)); });
+
+        auto variant_shapes = make_variant(layout);
+        bm::run("shuffled: std::variant + std::visit", count, [&] { bm::do_not_optimize(render_all(variant_shapes)); });
+    }
+}
@@ -0,0 +1,35 @@
+#include "channel.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <exec/task.hpp>
+#include <stdexec/execution.hpp>
+#include <string>
+
+exec::task<int> produce_words(coro::channel<std::string>& ch, int count)
+{
+    int sent = 0;
+    for (int i = 0; i < count; ++i)
+        if (co_await ch.send("word-" + std::to_string(i)))
+            ++sent;
+
+    ch.close();
+    co_return sent;
+}
+
+exec::task<std::size_t> count_letters(coro::channel<std::string>& ch)
+{
+    std::size_t letters = 0;
+    while (auto word = co_await ch.receive())
+        letters += word->size();
+    co_return letters;
+}
+
+TEST_CASE("channel - pipeline of exec::task stages")
+{
+    coro::channel<std::string> ch{4};
+
+    auto [sent, letters] = stdexec::sync_wait(stdexec::when_all(produce_words(ch, 100), count_letters(ch))).value();
+
+    CHECK(sent == 100);
+    CHECK(letters == 10 * 6 + 90 * 7);
+}
@@ -0,0 +1,313 @@
+#include "future_awaiter.hpp"
+#include "on_scheduler.hpp"
+#include "task_resumer.hpp"
+
+#include <atomic>
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <coroutine>
+#include <cstdlib>
+#include <exec/static_thread_pool.hpp>
+#include <exec/task.hpp>
+#include <future>
+#include <iostream>
+#include <new>
+#include <stdexec/execution.hpp>
+#include <string>
+
+// Allocation counter (replaced global operator new/delete) - this file is built as its own
+// executable (see CMakeLists.txt), other tests are not affected
+namespace
+{
+    std::atomic<std::size_t> allocation_count{0};
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(std::size_t size)
+{
+    if (void* ptr = operator new(size, std::nothrow))
+        return ptr;
+
+    throw std::bad_alloc{};
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+namespace overhead
+{
+    // TaskResumer without frame pooling - frames come from the global operator new
+    class PlainResumer
+    {
+    public:
+        struct promise_type
+        {
+            PlainResumer get_return_object()
+            {
+                return PlainResumer{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            { }
+
+            void unhandled_exception()
+            {
+                std::terminate();
+            }
+        };
+
+        explicit PlainResumer(std::coroutine_handle<promise_type> coro_hndl)
+            : coro_hndl_{coro_hndl}
+        { }
+
+        PlainResumer(const PlainResumer&) = delete;
+        PlainResumer& operator=(const PlainResumer&) = delete;
+
+        ~PlainResumer()
+        {
+            coro_hndl_.destroy();
+        }
+
+        bool resume() const
+        {
+            coro_hndl_.resume();
+            return !coro_hndl_.done();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> coro_hndl_;
+    };
+
+    // Coroutines that can be inlined into the caller are candidates for heap allocation
+    // elision (HALO); the noinline variants always allocate their frames.
+
+    PlainResumer empty_coroutine()
+    {
+        co_return;
+    }
+
+    [[gnu::noinline]] PlainResumer empty_coroutine_noinline()
+    {
+        co_return;
+    }
+
+    TaskResumer empty_pooled_coroutine()
+    {
+        co_return;
+    }
+
+    PlainResumer counting_coroutine(long& counter)
+    {
+        while (true)
+        {
+            ++counter;
+            co_await std::suspend_always{};
+        }
+    }
+
+    [[gnu::noinline]] PlainResumer counting_coroutine_noinline(long& counter)
+    {
+        while (true)
+        {
+            ++counter;
+            co_await std::suspend_always{};
+        }
+    }
+
+    [[gnu::noinline]] void increment(long& counter)
+    {
+        ++counter;
+    }
+
+    exec::task<int> value(int n)
+    {
+        co_return n;
+    }
+
+    [[gnu::noinline]] exec::task<int> value_noinline(int n)
+    {
+        co_return n;
+    }
+
+    exec::task<long> sum_of_values(int count)
+    {
+        long sum = 0;
+        for (int i = 0; i < count; ++i)
+            sum += co_await value(i);
+        co_return sum;
+    }
+
+    exec::task<long> sum_of_values_noinline(int count)
+    {
+        long sum = 0;
+        for (int i = 0; i < count; ++i)
+            sum += co_await value_noinline(i);
+        co_return sum;
+    }
+
+    exec::task<int> nested_chain(int depth)
+    {
+        if (depth == 0)
+            co_return 0;
+        co_return 1 + co_await nested_chain(depth - 1);
+    }
+
+    exec::task<long> sum_of_ready_futures(int count)
+    {
+        long sum = 0;
+        for (int i = 0; i < count; ++i)
+        {
+            std::promise<int> promise;
+            promise.set_value(i);
+            sum += co_await FutureAwaiter<int>{promise.get_future()};
+        }
+        co_return sum;
+    }
+
+    exec::task<long> sum_of_async_futures(int count)
+    {
+        long sum = 0;
+        for (int i = 0; i < count; ++i)
+            sum += co_await async_task([](int a, int b) { return a + b; }, i, 0);
+        co_return sum;
+    }
+
+    exec::task<long> sum_of_pool_results(exec::static_thread_pool& pool, int count)
+    {
+        long sum = 0;
+        for (int i = 0; i < count; ++i)
+            sum += co_await on(pool, [](int a, int b) { return a + b; }, i, 0);
+        co_return sum;
+    }
+
+    template <typename Task>
+    auto sync_result(Task task)
+    {
+        auto [result] = stdexec::sync_wait(std::move(task)).value();
+        return result;
+    }
+} // namespace overhead
+
+TEST_CASE("coroutine overhead - benchmarked coroutines")
+{
+    using namespace overhead;
+
+    long counter = 0;
+    auto counting = counting_coroutine(counter);
+    counting.resume();
+    counting.resume();
+    CHECK(counter == 2);
+
+    CHECK(sync_result(sum_of_values(10)) == 45);
+    CHECK(sync_result(sum_of_values_noinline(10)) == 45);
+    CHECK(sync_result(nested_chain(10)) == 10);
+    CHECK(sync_result(sum_of_ready_futures(10)) == 45);
+    CHECK(sync_result(sum_of_async_futures(3)) == 3);
+
+    exec::static_thread_pool pool{1};
+    CHECK(sync_result(sum_of_pool_results(pool, 10)) == 45);
+}
+
+TEST_CASE("coroutine overhead benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+    using namespace overhead;
+
+    // best time per operation + allocations per operation from an extra run
+    auto run = [](std::string name, std::size_t ops, auto&& fn) {
+        auto result = bm::measure(std::move(name), ops, fn);
+
+        const auto allocations_before = allocation_count.load(std::memory_order_relaxed);
+        fn();
+        result.allocations_per_op = static_cast<double>(allocation_count.load(std::memory_order_relaxed) - allocations_before) / ops;
+
+        std::cout << result << "\n";
+    };
+
+    constexpr int count = 1'000'000;
+
+    std::cout << "--- create + destroy\n";
+    run("TaskResumer-style - HALO candidate", count, [] {
+        for (int i = 0; i < count; ++i)
+        {
+            auto task = empty_coroutine();
+            task.resume();
+        }
+    });
+    run("TaskResumer-style - noinline (no elision)", count, [] {
+        for (int i = 0; i < count; ++i)
+        {
+            auto task = empty_coroutine_noinline();
+            task.resume();
+        }
+    });
+    run("TaskResumer - pooled frames", count, [] {
+        for (int i = 0; i < count; ++i)
+        {
+            auto task = empty_pooled_coroutine();
+            task.resume();
+        }
+    });
+
+    std::cout << "--- resume vs function call\n";
+    long counter = 0;
+    run("function call (noinline)", count, [&] {
+        for (int i = 0; i < count; ++i)
+            increment(counter);
+    });
+    run("resume() - HALO candidate", count, [&] {
+        auto task = counting_coroutine(counter);
+        for (int i = 0; i < count; ++i)
+            task.resume();
+    });
+    run("resume() - noinline (no elision)", count, [&] {
+        auto task = counting_coroutine_noinline(counter);
+        for (int i = 0; i < count; ++i)
+            task.resume();
+    });
+    bm::do_not_optimize(counter);
+
+    std::cout << "--- exec::task co_await\n";
+    run("co_await exec::task - HALO candidate", count, [] { bm::do_not_optimize(sync_result(sum_of_values(count))); });
+    run("co_await exec::task - noinline (no elision)", count, [] { bm::do_not_optimize(sync_result(sum_of_values_noinline(count))); });
+
+    constexpr int depth = 1'000;
+    run("nested co_await chain (per level)", depth, [] { bm::do_not_optimize(sync_result(nested_chain(depth))); });
+
+    std::cout << "--- FutureAwaiter\n";
+    constexpr int ready_count = 100'000;
+    run("co_await FutureAwaiter - ready future", ready_count, [] { bm::do_not_optimize(sync_result(sum_of_ready_futures(ready_count))); });
+
+    constexpr int async_count = 200;
+    run("co_await async_task - std::async + completion service", async_count, [] { bm::do_not_optimize(sync_result(sum_of_async_futures(async_count))); });
+
+    exec::static_thread_pool pool{1};
+    run("co_await on(pool, ...) - exec::static_thread_pool", async_count, [&] { bm::do_not_optimize(sync_result(sum_of_pool_results(pool, async_count))); });
+}
@@ -1,6 +1,12 @@
+#include "future_awaiter.hpp"
+#include "on_scheduler.hpp"
+
 #include <catch2/catch_test_macros.hpp>
+#include <exec/static_thread_pool.hpp>
 #include <exec/task.hpp>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <stdexec/execution.hpp>
 #include <string>
 #include <vector>
@@ -64,40 +70,6 @@ TEST_CASE("processing_value")
 //////////////////////////////////////////////////////
 // Awaiter for std::future
 
-template <typename T>
-class FutureAwaiter
-{
-    std::future<T> future_;
-public:
-    FutureAwaiter(std::future<T>&& ftr) : future_(std::move(ftr)) {}
-
-    bool await_ready() const noexcept
-    {
-        using namespace std::literals;
-        return future_.wait_for(0s) == std::future_status::ready;
-    }
-
-    void await_suspend(std::coroutine_handle<> coro_handle)
-    {
-        std::thread([this, coro_handle]() mutable {
-            future_.wait();
-            coro_handle.resume();
-        }).detach();
-    }
-
-    T await_resume()
-    {
-        return future_.get();
-    }
-};
-
-template <typename F, typename... Args>
-auto async_task(F&& func, Args&&... args) -> FutureAwaiter<decltype(func(std::forward<Args>(args)...))>
-{
-    using ReturnType = decltype(func(std::forward<Args>(args)...));
-    return FutureAwaiter<ReturnType>(std::async(std::launch::async, std::forward<F>(func), std::forward<Args>(args)...));
-}
-
 int slow_add(int a, int b)
 {
     std::cout << "Starting slow_add(" << a << ", " << b << ") on thread " << std::this_thread::get_id() << std::endl;
@@ -131,4 +103,63 @@ TEST_CASE("demo_async_task")
 
     CHECK(result_1 == "Result is 15");
     CHECK(result_2 == "Result is 35");
-}
\ No newline at end of file
+}
+
+//////////////////////////////////////////////////////
+// Running a function on a stdexec scheduler
+
+exec::task<std::string> demo_on_pool(exec::static_thread_pool& pool, int a, int b)
+{
+    std::cout << "Starting task on thread " << std::this_thread::get_id() << std::endl;
+    int result = co_await on(pool, slow_add, a, b); // no thread is created for the call
+    std::cout << "slow_add completed with result: " << result << " on thread " << std::this_thread::get_id() << std::endl;
+    co_return "Result is " + std::to_string(result);
+}
+
+TEST_CASE("demo_on_pool")
+{
+    exec::static_thread_pool pool{2};
+
+    auto [result_1, result_2] = stdexec::sync_wait(stdexec::when_all(demo_on_pool(pool, 5, 10), demo_on_pool(pool, 15, 20))).value();
+
+    CHECK(result_1 == "Result is 15");
+    CHECK(result_2 == "Result is 35");
+}
+
+exec::task<std::thread::id> id_of_calling_thread(exec::static_thread_pool& pool)
+{
+    co_return co_await on(pool, [] { return std::this_thread::get_id(); });
+}
+
+exec::task<std::string> failing_on_pool(exec::static_thread_pool& pool)
+{
+    try
+    {
+        co_await on(pool, [](std::unique_ptr<int> value) -> int { throw std::runtime_error{"error " + std::to_string(*value)}; },
+            std::make_unique<int>(42));
+    }
+    catch (const std::runtime_error& e)
+    {
+        co_return e.what();
+    }
+    co_return "no error";
+}
+
+TEST_CASE("on - function runs on the pool")
+{
+    exec::static_thread_pool pool{2};
+
+    SECTION("called on a thread of the pool")
+    {
+        auto [id] = stdexec::sync_wait(id_of_calling_thread(pool)).value();
+
+        CHECK(id != std::this_thread::get_id());
+    }
+
+    SECTION("move-only arguments, exception is rethrown by co_await")
+    {
+        auto [error] = stdexec::sync_wait(failing_on_pool(pool)).value();
+
+        CHECK(error == "error 42");
+    }
+}
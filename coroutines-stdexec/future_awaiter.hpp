@@ -0,0 +1,138 @@
+#ifndef FUTURE_AWAITER_HPP
+#define FUTURE_AWAITER_HPP
+
+#include "future_completion_service.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <future>
+#include <memory>
+#include <utility>
+
+// Awaiter for std::future - the coroutine is resumed by a FutureCompletionService when the result is ready
+// (no thread is blocked per co_await)
+template <typename T>
+class FutureAwaiter : PendingCompletion
+{
+    std::future<T> future_;
+    FutureCompletionService& service_;
+
+    static bool is_ready(PendingCompletion* pending) noexcept
+    {
+        return static_cast<FutureAwaiter*>(pending)->await_ready();
+    }
+
+public:
+    FutureAwaiter(std::future<T>&& ftr, FutureCompletionService& service = default_future_completion_service())
+        : PendingCompletion{&is_ready, {}}
+        , future_(std::move(ftr))
+        , service_{service}
+    { }
+
+    bool await_ready() const noexcept
+    {
+        using namespace std::literals;
+        return future_.wait_for(0s) != std::future_status::timeout; // a deferred function is run by get()
+    }
+
+    void await_suspend(std::coroutine_handle<> coro_handle)
+    {
+        coro = coro_handle;
+        service_.add(this);
+    }
+
+    T await_resume()
+    {
+        return future_.get();
+    }
+};
+
+// Completion handshake of async_task - shared by the awaiter and the thread running the task.
+// Whichever comes second (suspended awaiter or finished task) hands the coroutine to the service.
+class CompletionSignal
+{
+    std::atomic<PendingCompletion*> waiting_{nullptr}; // awaiter, or finished_marker() after finish()
+    FutureCompletionService& service_;
+
+    static PendingCompletion* finished_marker() noexcept
+    {
+        static PendingCompletion marker{nullptr, {}};
+        return &marker;
+    }
+
+public:
+    explicit CompletionSignal(FutureCompletionService& service)
+        : service_{service}
+    { }
+
+    // Called by the task after its result is stored
+    void finish()
+    {
+        if (auto* awaiting = waiting_.exchange(finished_marker(), std::memory_order_acq_rel))
+            service_.complete(awaiting);
+    }
+
+    // false if the task has already finished - the coroutine must not be suspended
+    bool await(PendingCompletion* pending) noexcept
+    {
+        PendingCompletion* expected = nullptr;
+        return waiting_.compare_exchange_strong(expected, pending, std::memory_order_acq_rel);
+    }
+};
+
+// Awaiter for async_task - the task signals the service when its result is ready (no polling)
+template <typename T>
+class AsyncTaskAwaiter : PendingCompletion
+{
+    std::future<T> result_;
+    std::future<void> thread_; // std::async - waits for the thread running the task on destruction
+    std::shared_ptr<CompletionSignal> signal_;
+
+public:
+    AsyncTaskAwaiter(std::future<T> result, std::future<void> thread, std::shared_ptr<CompletionSignal> signal)
+        : PendingCompletion{nullptr, {}}
+        , result_{std::move(result)}
+        , thread_{std::move(thread)}
+        , signal_{std::move(signal)}
+    { }
+
+    bool await_ready() const noexcept
+    {
+        using namespace std::literals;
+        return result_.wait_for(0s) == std::future_status::ready;
+    }
+
+    bool await_suspend(std::coroutine_handle<> coro_handle)
+    {
+        coro = coro_handle;
+        return signal_->await(this);
+    }
+
+    T await_resume()
+    {
+        return result_.get();
+    }
+};
+
+// Runs func(args...) on a new thread (as std::async) - arguments are decay-copied
+template <typename F, typename... Args>
+auto async_task(F&& func, Args&&... args) -> AsyncTaskAwaiter<decltype(func(std::forward<Args>(args)...))>
+{
+    using ReturnType = decltype(func(std::forward<Args>(args)...));
+
+    std::packaged_task<ReturnType()> task{[func = std::forward<F>(func), ... args = std::forward<Args>(args)]() mutable {
+        return std::invoke(std::move(func), std::move(args)...);
+    }};
+    auto result = task.get_future();
+    auto signal = std::make_shared<CompletionSignal>(default_future_completion_service());
+
+    auto thread = std::async(std::launch::async, [task = std::move(task), signal]() mutable {
+        task(); // stores the result or the exception
+        signal->finish();
+    });
+
+    return AsyncTaskAwaiter<ReturnType>{std::move(result), std::move(thread), std::move(signal)};
+}
+
+#endif
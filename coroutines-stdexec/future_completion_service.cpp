@@ -0,0 +1,269 @@
+#include "detached_task.hpp"
+#include "future_awaiter.hpp"
+#include "future_completion_service.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <stdexcept>
+#include <stdexec/execution.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using helpers::benchmark::os_thread_count;
+
+    // Previous FutureAwaiter - a detached thread blocks on the future for each co_await
+    template <typename T>
+    class ThreadPerAwaitFutureAwaiter
+    {
+        std::future<T> future_;
+
+    public:
+        explicit ThreadPerAwaitFutureAwaiter(std::future<T>&& ftr)
+            : future_(std::move(ftr))
+        { }
+
+        bool await_ready() const noexcept
+        {
+            using namespace std::literals;
+            return future_.wait_for(0s) == std::future_status::ready;
+        }
+
+        void await_suspend(std::coroutine_handle<> coro_handle)
+        {
+            std::thread([this, coro_handle] {
+                future_.wait();
+                coro_handle.resume();
+            }).detach();
+        }
+
+        T await_resume()
+        {
+            return future_.get();
+        }
+    };
+
+    template <typename Awaiter>
+    coro::detached_task add_result(Awaiter awaiter, std::atomic<long>& sum, std::latch& done)
+    {
+        sum += co_await std::move(awaiter);
+        done.count_down();
+    }
+
+    // Starts `count` coroutines awaiting futures, then completes the futures.
+    // Returns the number of OS threads while all coroutines were suspended.
+    template <typename MakeAwaiter>
+    std::size_t await_futures(int count, MakeAwaiter make_awaiter, std::atomic<long>& sum)
+    {
+        std::vector<std::promise<int>> promises(count);
+        std::latch done{count};
+
+        for (auto& promise : promises)
+            add_result(make_awaiter(promise.get_future()), sum, done);
+
+        const auto threads = os_thread_count();
+
+        for (int i = 0; i < count; ++i)
+            promises[i].set_value(i);
+        done.wait();
+
+        return threads;
+    }
+} // namespace
+
+TEST_CASE("future completion service - many pending futures share the waiter threads")
+{
+    constexpr int count = 200;
+
+    FutureCompletionService service{2};
+    std::atomic<long> sum{0};
+    const auto threads_before = os_thread_count();
+
+    const auto threads_while_waiting = await_futures(count, [&](std::future<int> f) { return FutureAwaiter<int>{std::move(f), service}; }, sum);
+
+    CHECK(sum == count * (count - 1) / 2);
+    CHECK(threads_while_waiting == threads_before);
+}
+
+coro::detached_task record_resuming_thread(std::future<std::string> f, FutureCompletionService& service, std::vector<std::string>& results,
+    std::vector<std::thread::id>& threads, stdexec::run_loop& loop, int& remaining)
+{
+    results.push_back(co_await FutureAwaiter<std::string>{std::move(f), service});
+    threads.push_back(std::this_thread::get_id());
+    if (--remaining == 0)
+        loop.finish();
+}
+
+TEST_CASE("future completion service - coroutines are resumed on the given scheduler")
+{
+    stdexec::run_loop loop;
+    FutureCompletionService service{loop.get_scheduler()};
+
+    std::promise<std::string> first, second;
+    std::vector<std::string> results;
+    std::vector<std::thread::id> threads;
+    int remaining = 2;
+
+    record_resuming_thread(first.get_future(), service, results, threads, loop, remaining);
+    record_resuming_thread(second.get_future(), service, results, threads, loop, remaining);
+
+    std::jthread producer{[&] {
+        second.set_value("second");
+        first.set_value("first");
+    }};
+
+    loop.run(); // resumes the coroutines on this thread until finish()
+
+    std::ranges::sort(results);
+    CHECK(results == std::vector<std::string>{"first", "second"});
+    CHECK(threads == std::vector<std::thread::id>(2, std::this_thread::get_id()));
+}
+
+coro::detached_task store_error(std::future<int> f, std::string& error, std::latch& done)
+{
+    try
+    {
+        co_await FutureAwaiter<int>{std::move(f)};
+    }
+    catch (const std::runtime_error& e)
+    {
+        error = e.what();
+    }
+    done.count_down();
+}
+
+TEST_CASE("future completion service - exception from the future is rethrown")
+{
+    std::promise<int> promise;
+    std::string error;
+    std::latch done{1};
+
+    store_error(promise.get_future(), error, done); // default service
+
+    promise.set_exception(std::make_exception_ptr(std::runtime_error{"failed"}));
+    done.wait();
+
+    CHECK(error == "failed");
+}
+
+namespace
+{
+    // Completed by complete() right after suspension - counts the polls of is_ready
+    struct SignalledAwaiter : PendingCompletion
+    {
+        FutureCompletionService& service;
+        int polls = 0;
+
+        static bool count_poll(PendingCompletion* pending) noexcept
+        {
+            ++static_cast<SignalledAwaiter*>(pending)->polls;
+            return false;
+        }
+
+        explicit SignalledAwaiter(FutureCompletionService& service)
+            : PendingCompletion{&count_poll, {}}
+            , service{service}
+        { }
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> coro_handle)
+        {
+            coro = coro_handle;
+            service.complete(this);
+        }
+
+        int await_resume() const noexcept
+        {
+            return polls;
+        }
+    };
+
+    coro::detached_task await_signalled(FutureCompletionService& service, int& polls, std::thread::id& resumed_on, std::latch& done)
+    {
+        polls = co_await SignalledAwaiter{service};
+        resumed_on = std::this_thread::get_id();
+        done.count_down();
+    }
+
+    coro::detached_task sum_async_tasks(int count, std::atomic<long>& sum, std::string& error, std::latch& done)
+    {
+        for (int i = 0; i < count; ++i)
+            sum += co_await async_task([](std::unique_ptr<int> n) { return *n; }, std::make_unique<int>(i));
+
+        try
+        {
+            co_await async_task([] { throw std::runtime_error{"failed"}; });
+        }
+        catch (const std::runtime_error& e)
+        {
+            error = e.what();
+        }
+        done.count_down();
+    }
+} // namespace
+
+TEST_CASE("future completion service - signalled completions are resumed without polling")
+{
+    FutureCompletionService service{1};
+    int polls = -1;
+    std::thread::id resumed_on;
+    std::latch done{1};
+
+    await_signalled(service, polls, resumed_on, done);
+    done.wait();
+
+    CHECK(polls == 0);
+    CHECK(resumed_on != std::this_thread::get_id()); // on the waiter thread
+}
+
+TEST_CASE("future completion service - async_task signals its completion")
+{
+    std::atomic<long> sum{0};
+    std::string error;
+    std::latch done{1};
+
+    sum_async_tasks(20, sum, error, done);
+    done.wait();
+
+    CHECK(sum == 190);
+    CHECK(error == "failed");
+}
+
+TEST_CASE("future completion service benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+
+    for (int count : {100, 1'000})
+    {
+        std::cout << "--- " << count << " pending futures\n";
+
+        auto run = [count](std::string name, auto make_awaiter) {
+            std::atomic<long> sum{0};
+            std::size_t threads = 0;
+            auto result = bm::measure(std::move(name), count, [&] { threads = await_futures(count, make_awaiter, sum); }, 5);
+            std::cout << result << std::setw(8) << threads << " OS threads while waiting\n";
+        };
+
+        run("thread per co_await", [](std::future<int> f) { return ThreadPerAwaitFutureAwaiter<int>{std::move(f)}; });
+
+        for (std::size_t waiter_count : {1, 4})
+        {
+            FutureCompletionService service{waiter_count};
+            run("completion service - " + std::to_string(waiter_count) + " waiter thread(s)",
+                [&](std::future<int> f) { return FutureAwaiter<int>{std::move(f), service}; });
+        }
+    }
+}
@@ -0,0 +1,265 @@
+#ifndef FUTURE_COMPLETION_SERVICE_HPP
+#define FUTURE_COMPLETION_SERVICE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexec/execution.hpp>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <cstdint>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+// Pending co_await on something that can only be polled (std::future has no completion callback) or that is
+// signalled by its producer (is_ready is not used then). Linked intrusively into the service - the awaiter
+// lives in the suspended coroutine frame.
+struct PendingCompletion
+{
+    bool (*is_ready)(PendingCompletion*) noexcept;
+    std::coroutine_handle<> coro;
+    PendingCompletion* next = nullptr;
+};
+
+// A few waiter threads multiplex all pending completions (instead of a blocked thread per co_await):
+//  - completions signalled by their producer (complete()) are pushed to a lock-free stack of a waiter,
+//    which is woken up via eventfd - no polling
+//  - foreign futures (add()) are pushed to another stack of a waiter and polled; while nothing completes,
+//    the poll interval grows from min_poll_interval up to max_poll_interval (the waiter sleeps on the
+//    eventfd in between)
+//  - completed coroutines are resumed on the configured stdexec scheduler (inline on the waiter
+//    thread by default)
+class FutureCompletionService
+{
+public:
+    using Resume = std::function<void(std::coroutine_handle<>)>;
+
+    static constexpr std::chrono::microseconds min_poll_interval{20};
+    static constexpr std::chrono::microseconds max_poll_interval{1000};
+
+    explicit FutureCompletionService(std::size_t waiter_count = 1)
+        : FutureCompletionService{[](std::coroutine_handle<> coro) { coro.resume(); }, waiter_count}
+    { }
+
+    template <stdexec::scheduler Scheduler>
+    explicit FutureCompletionService(Scheduler scheduler, std::size_t waiter_count = 1)
+        : FutureCompletionService{
+              [scheduler](std::coroutine_handle<> coro) {
+                  stdexec::start_detached(stdexec::schedule(scheduler) | stdexec::then([coro] { coro.resume(); }));
+              },
+              waiter_count}
+    { }
+
+    FutureCompletionService(Resume resume, std::size_t waiter_count)
+        : resume_{std::move(resume)}
+        , waiters_(std::max<std::size_t>(waiter_count, 1))
+    {
+        for (auto& waiter : waiters_)
+            waiter.thread = std::jthread{[this, &waiter] { run(waiter); }};
+    }
+
+    FutureCompletionService(const FutureCompletionService&) = delete;
+    FutureCompletionService& operator=(const FutureCompletionService&) = delete;
+
+    // Coroutines still waiting at destruction are not resumed
+    ~FutureCompletionService()
+    {
+        stop_.store(true, std::memory_order_relaxed);
+        for (auto& waiter : waiters_)
+        {
+            waiter.wakeup.notify();
+            waiter.thread.join();
+        }
+    }
+
+    std::size_t waiter_count() const noexcept
+    {
+        return waiters_.size();
+    }
+
+    // Polls pending->is_ready until it returns true
+    void add(PendingCompletion* pending)
+    {
+        auto& waiter = next_waiter();
+        push(waiter, waiter.incoming, pending);
+    }
+
+    // Resumes the coroutine of a completion signalled by its producer
+    void complete(PendingCompletion* pending)
+    {
+        auto& waiter = next_waiter();
+        push(waiter, waiter.ready, pending);
+    }
+
+private:
+#if defined(__linux__)
+    class Wakeup
+    {
+        int fd_;
+
+    public:
+        Wakeup()
+            : fd_{::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)}
+        {
+            if (fd_ < 0)
+                throw std::system_error{errno, std::system_category(), "eventfd"};
+        }
+
+        Wakeup(const Wakeup&) = delete;
+        Wakeup& operator=(const Wakeup&) = delete;
+
+        ~Wakeup()
+        {
+            ::close(fd_);
+        }
+
+        void notify() noexcept
+        {
+            const std::uint64_t one = 1;
+            [[maybe_unused]] auto written = ::write(fd_, &one, sizeof(one));
+        }
+
+        // timeout < 0 - waits until notified
+        void wait(std::chrono::microseconds timeout) noexcept
+        {
+            pollfd fd{.fd = fd_, .events = POLLIN, .revents = 0};
+            const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            const timespec ts{.tv_sec = seconds.count(), .tv_nsec = std::chrono::nanoseconds{timeout - seconds}.count()};
+            if (::ppoll(&fd, 1, timeout.count() < 0 ? nullptr : &ts, nullptr) > 0)
+            {
+                std::uint64_t value;
+                [[maybe_unused]] auto read = ::read(fd_, &value, sizeof(value));
+            }
+        }
+    };
+#else
+    class Wakeup
+    {
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        bool notified_ = false;
+
+    public:
+        void notify()
+        {
+            {
+                std::lock_guard lk{mtx_};
+                notified_ = true;
+            }
+            cv_.notify_one();
+        }
+
+        void wait(std::chrono::microseconds timeout)
+        {
+            std::unique_lock lk{mtx_};
+            if (timeout.count() < 0)
+                cv_.wait(lk, [this] { return notified_; });
+            else
+                cv_.wait_for(lk, timeout, [this] { return notified_; });
+            notified_ = false;
+        }
+    };
+#endif
+
+    struct Waiter
+    {
+        std::atomic<PendingCompletion*> incoming{nullptr}; // to be polled
+        std::atomic<PendingCompletion*> ready{nullptr};    // signalled
+        Wakeup wakeup;
+        std::jthread thread;
+    };
+
+    Resume resume_;
+    std::atomic<bool> stop_{false};
+    std::atomic<std::size_t> next_waiter_{0};
+    std::vector<Waiter> waiters_;
+
+    Waiter& next_waiter() noexcept
+    {
+        return waiters_[next_waiter_.fetch_add(1, std::memory_order_relaxed) % waiters_.size()];
+    }
+
+    static void push(Waiter& waiter, std::atomic<PendingCompletion*>& stack, PendingCompletion* pending)
+    {
+        auto* head = stack.load(std::memory_order_relaxed);
+        do
+            pending->next = head;
+        while (!stack.compare_exchange_weak(head, pending, std::memory_order_release, std::memory_order_relaxed));
+
+        // a non-empty stack has already been signalled and not yet taken by the waiter
+        if (!head)
+            waiter.wakeup.notify();
+    }
+
+    void run(Waiter& waiter)
+    {
+        std::vector<PendingCompletion*> pending;
+        auto poll_interval = min_poll_interval;
+
+        while (!stop_.load(std::memory_order_relaxed))
+        {
+            for (auto* added = waiter.incoming.exchange(nullptr, std::memory_order_acquire); added; added = added->next)
+                pending.push_back(added);
+
+            bool completed = false;
+            for (auto* ready = waiter.ready.exchange(nullptr, std::memory_order_acquire); ready;)
+            {
+                // the awaiter may be destroyed by the resumed coroutine
+                const auto coro = ready->coro;
+                ready = ready->next;
+                resume_(coro);
+                completed = true;
+            }
+
+            for (std::size_t i = 0; i < pending.size();)
+            {
+                if (!pending[i]->is_ready(pending[i]))
+                {
+                    ++i;
+                    continue;
+                }
+
+                // the awaiter may be destroyed by the resumed coroutine
+                const auto coro = pending[i]->coro;
+                pending[i] = pending.back();
+                pending.pop_back();
+                resume_(coro);
+                completed = true;
+            }
+
+            if (pending.empty())
+            {
+                waiter.wakeup.wait(std::chrono::microseconds{-1});
+                poll_interval = min_poll_interval;
+            }
+            else
+            {
+                poll_interval = completed ? min_poll_interval : std::min(poll_interval * 2, max_poll_interval);
+                waiter.wakeup.wait(poll_interval);
+            }
+        }
+    }
+};
+
+// Service used by FutureAwaiter unless another one is given - one waiter thread, coroutines are resumed on it
+inline FutureCompletionService& default_future_completion_service()
+{
+    static FutureCompletionService service{1};
+    return service;
+}
+
+#endif
@@ -0,0 +1,274 @@
+#include "io_uring_context.hpp"
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <exec/task.hpp>
+#include <fcntl.h>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexec/execution.hpp>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+    // Removed together with the object
+    class TempFile
+    {
+        std::string path_;
+        int fd_;
+
+    public:
+        explicit TempFile(const std::filesystem::path& directory = std::filesystem::temp_directory_path())
+            : path_{(directory / "io_uring_context_XXXXXX").string()}
+            , fd_{::mkstemp(path_.data())}
+        {
+            if (fd_ < 0)
+                throw std::system_error{errno, std::system_category(), "mkstemp"};
+        }
+
+        TempFile(const TempFile&) = delete;
+        TempFile& operator=(const TempFile&) = delete;
+
+        ~TempFile()
+        {
+            ::close(fd_);
+            ::unlink(path_.c_str());
+        }
+
+        int fd() const noexcept
+        {
+            return fd_;
+        }
+
+        const std::string& path() const noexcept
+        {
+            return path_;
+        }
+    };
+
+    std::vector<std::byte> pattern(std::size_t size)
+    {
+        std::vector<std::byte> data(size);
+        for (std::size_t i = 0; i < size; ++i)
+            data[i] = static_cast<std::byte>(i * 31 % 251);
+        return data;
+    }
+
+    exec::task<std::vector<std::byte>> write_and_read_back(IoUringContext& io, int fd, std::span<const std::byte> data)
+    {
+        co_await io.async_write(fd, data, 0);
+
+        std::vector<std::byte> result(data.size());
+        std::size_t total = 0;
+        while (total < result.size())
+        {
+            const auto bytes = co_await io.async_read_some(fd, std::span{result}.subspan(total), total);
+            if (bytes == 0)
+                break;
+            total += bytes;
+        }
+        result.resize(total);
+        co_return result;
+    }
+
+    const char* name(IoBackend backend)
+    {
+        return backend == IoBackend::io_uring ? "io_uring" : "thread pool";
+    }
+} // namespace
+
+TEST_CASE("io_uring context - write and read back")
+{
+    for (auto preferred : {IoBackend::io_uring, IoBackend::thread_pool})
+    {
+        IoUringContext io{preferred};
+        TempFile file;
+        const auto data = pattern(1'000'003);
+
+        INFO("backend: " << name(io.backend()));
+
+        auto [result] = stdexec::sync_wait(write_and_read_back(io, file.fd(), data)).value();
+        CHECK(result == data);
+    }
+}
+
+TEST_CASE("io_uring context - reads into registered buffers")
+{
+    for (auto preferred : {IoBackend::io_uring, IoBackend::thread_pool})
+    {
+        IoUringContext io{preferred};
+        TempFile file;
+        const auto data = pattern(64 * 1024);
+        stdexec::sync_wait(io.async_write(file.fd(), data, 0));
+
+        std::vector<std::byte> registered(128 * 1024);
+        const std::span<std::byte> buffers[] = {registered};
+        io.register_buffers(buffers);
+
+        INFO("backend: " << name(io.backend()));
+
+        // part of a registered buffer - fixed-buffer read
+        auto [bytes] = stdexec::sync_wait(io.async_read_some(file.fd(), std::span{registered}.subspan(1000, 4096), 512)).value();
+        CHECK(bytes == 4096);
+        CHECK(std::equal(registered.begin() + 1000, registered.begin() + 1000 + 4096, data.begin() + 512));
+
+        // reading at the end of the file
+        auto [at_end] = stdexec::sync_wait(io.async_read_some(file.fd(), registered, data.size())).value();
+        CHECK(at_end == 0);
+    }
+}
+
+TEST_CASE("io_uring context - errors are sent as std::error_code")
+{
+    for (auto preferred : {IoBackend::io_uring, IoBackend::thread_pool})
+    {
+        IoUringContext io{preferred};
+        std::vector<std::byte> buffer(16);
+
+        INFO("backend: " << name(io.backend()));
+
+        try
+        {
+            stdexec::sync_wait(io.async_read_some(-1, buffer, 0));
+            FAIL("read from an invalid descriptor succeeded");
+        }
+        catch (const std::system_error& e)
+        {
+            CHECK(e.code() == std::error_code{EBADF, std::system_category()});
+        }
+    }
+}
+
+TEST_CASE("io_uring context - more operations than ring entries")
+{
+    constexpr std::size_t count = 1'000;
+    constexpr std::size_t block = 512;
+
+    IoUringContext io{IoBackend::io_uring, 8};
+    TempFile file;
+    const auto data = pattern(count * block);
+    stdexec::sync_wait(io.async_write(file.fd(), data, 0));
+
+    std::vector<std::byte> result(data.size());
+    std::latch done{count};
+
+    // operations over the capacity of the completion queue wait in the backlog
+    for (std::size_t i = 0; i < count; ++i)
+        stdexec::start_detached(io.async_read_some(file.fd(), std::span{result}.subspan(i * block, block), i * block)
+            | stdexec::then([&done](std::size_t) { done.count_down(); }));
+
+    done.wait();
+    CHECK(result == data);
+}
+
+namespace
+{
+    // Keeps one read in flight - the next read is started by the completion of the previous one
+    struct ReadLane
+    {
+        IoUringContext& io;
+        int fd;
+        std::span<std::byte> buffer;
+        std::atomic<std::uint64_t>& next_offset;
+        std::uint64_t file_size;
+        std::atomic<std::uint64_t>& bytes_read;
+        std::latch& done;
+
+        void read_next()
+        {
+            const auto offset = next_offset.fetch_add(buffer.size());
+            if (offset >= file_size)
+            {
+                done.count_down();
+                return;
+            }
+
+            stdexec::start_detached(io.async_read_some(fd, buffer, offset) | stdexec::then([this](std::size_t bytes) {
+                bytes_read += bytes;
+                read_next();
+            }));
+        }
+    };
+
+    // MB/s of reading the whole file with `queue_depth` reads in flight
+    double read_file(IoUringContext& io, int fd, std::uint64_t file_size, std::size_t queue_depth, std::size_t block_size)
+    {
+        auto* memory = static_cast<std::byte*>(std::aligned_alloc(4096, queue_depth * block_size)); // O_DIRECT alignment
+        const std::unique_ptr<std::byte, decltype(&std::free)> buffers{memory, &std::free};
+        const std::span<std::byte> registered[] = {{memory, queue_depth * block_size}};
+        io.register_buffers(registered);
+
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED); // no reads from the page cache without O_DIRECT
+
+        std::atomic<std::uint64_t> next_offset{0};
+        std::atomic<std::uint64_t> bytes_read{0};
+        std::latch done{static_cast<std::ptrdiff_t>(queue_depth)};
+        std::vector<ReadLane> lanes;
+        for (std::size_t i = 0; i < queue_depth; ++i)
+            lanes.push_back(ReadLane{io, fd, {memory + i * block_size, block_size}, next_offset, file_size, bytes_read, done});
+
+        const auto start = std::chrono::steady_clock::now();
+        for (auto& lane : lanes)
+            lane.read_next();
+        done.wait();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        CHECK(bytes_read == file_size);
+        return static_cast<double>(file_size) / 1e6 / elapsed.count();
+    }
+} // namespace
+
+TEST_CASE("io_uring context benchmark", "[.benchmark]")
+{
+    constexpr std::uint64_t file_size = std::uint64_t{2} << 30;
+    constexpr std::size_t block_size = 128 * 1024;
+
+    // in the working directory - the temporary directory may be in memory
+    TempFile file{std::filesystem::current_path()};
+    {
+        const auto chunk = pattern(8 << 20);
+        IoUringContext io;
+        for (std::uint64_t offset = 0; offset < file_size; offset += chunk.size())
+            stdexec::sync_wait(io.async_write(file.fd(), chunk, offset));
+        ::fsync(file.fd());
+    }
+
+    int fd = ::open(file.path().c_str(), O_RDONLY | O_DIRECT);
+    const bool direct = fd >= 0;
+    if (!direct)
+        fd = ::open(file.path().c_str(), O_RDONLY);
+
+    std::cout << "file: " << (file_size >> 20) << " MiB, blocks: " << block_size / 1024 << " KiB, "
+              << (direct ? "O_DIRECT" : "buffered (O_DIRECT not supported)") << "\n";
+
+    for (std::size_t queue_depth : {1, 2, 4, 8, 16, 32, 64})
+    {
+        std::cout << "--- queue depth " << queue_depth << "\n";
+
+        for (auto preferred : {IoBackend::io_uring, IoBackend::thread_pool})
+        {
+            // blocking reads - as many threads as reads in flight
+            IoUringContext io{preferred, 256, queue_depth};
+            const auto throughput = read_file(io, fd, file_size, queue_depth, block_size);
+
+            std::cout << std::left << std::setw(24) << name(io.backend()) << std::right << std::setw(10)
+                      << std::fixed << std::setprecision(0) << throughput << " MB/s\n";
+        }
+    }
+
+    ::close(fd);
+}
+
+#endif
@@ -0,0 +1,605 @@
+#ifndef IO_URING_CONTEXT_HPP
+#define IO_URING_CONTEXT_HPP
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <linux/io_uring.h>
+#include <mutex>
+#include <span>
+#include <stdexec/execution.hpp>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+enum class IoBackend
+{
+    io_uring,
+    thread_pool // blocking pread/pwrite on a few threads
+};
+
+// File I/O senders for exec::task - co_await io.async_read_some(fd, buffer, offset) doesn't block a thread.
+//  - io_uring is used through raw syscalls (no liburing); operation states are passed to the kernel
+//    as user_data - no allocations per operation
+//  - submission is batched: operations started by completion handlers (on the completion thread)
+//    are submitted together with a single io_uring_enter before the thread waits again;
+//    operations started on other threads are submitted immediately
+//  - reads into / writes from buffers registered with register_buffers() use the fixed-buffer opcodes
+//  - when io_uring is unavailable (old kernel, seccomp) the context falls back to a blocking thread pool
+// Receivers are completed on the completion thread (or a thread of the fallback pool).
+class IoUringContext
+{
+    struct IoOperation
+    {
+        void (*complete)(IoOperation*, int result) noexcept; // result - bytes transferred or -errno
+        bool write = false;
+        int fd = -1;
+        std::byte* buffer = nullptr;
+        unsigned length = 0;
+        std::uint64_t offset = 0;
+        int buffer_index = -1; // registered buffer containing [buffer, buffer + length)
+        IoOperation* next = nullptr;
+    };
+
+    struct OperationQueue
+    {
+        IoOperation* head = nullptr;
+        IoOperation* tail = nullptr;
+
+        bool empty() const noexcept
+        {
+            return head == nullptr;
+        }
+
+        void push(IoOperation* op) noexcept
+        {
+            op->next = nullptr;
+            (tail ? tail->next : head) = op;
+            tail = op;
+        }
+
+        IoOperation* pop() noexcept
+        {
+            auto* op = std::exchange(head, head->next);
+            if (!head)
+                tail = nullptr;
+            return op;
+        }
+    };
+
+    // Submission and completion queues shared with the kernel
+    class Ring
+    {
+        int fd_ = -1;
+        unsigned sq_entries_ = 0;
+        unsigned cq_entries_ = 0;
+        void* sq_ring_ = MAP_FAILED;
+        std::size_t sq_ring_size_ = 0;
+        void* cq_ring_ = MAP_FAILED;
+        std::size_t cq_ring_size_ = 0;
+        io_uring_sqe* sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+        std::size_t sqes_size_ = 0;
+
+        unsigned* sq_head_ = nullptr;
+        unsigned* sq_tail_ = nullptr;
+        unsigned sq_mask_ = 0;
+        unsigned* sq_array_ = nullptr;
+        unsigned* cq_head_ = nullptr;
+        unsigned* cq_tail_ = nullptr;
+        unsigned cq_mask_ = 0;
+        io_uring_cqe* cqes_ = nullptr;
+
+        template <typename T>
+        static T* at(void* ring, unsigned offset) noexcept
+        {
+            return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+        }
+
+        static unsigned load_acquire(unsigned* index) noexcept
+        {
+            return std::atomic_ref<unsigned>{*index}.load(std::memory_order_acquire);
+        }
+
+        static void store_release(unsigned* index, unsigned value) noexcept
+        {
+            std::atomic_ref<unsigned>{*index}.store(value, std::memory_order_release);
+        }
+
+    public:
+        Ring() = default;
+        Ring(const Ring&) = delete;
+        Ring& operator=(const Ring&) = delete;
+
+        ~Ring()
+        {
+            if (sqes_ != MAP_FAILED)
+                ::munmap(sqes_, sqes_size_);
+            if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+                ::munmap(cq_ring_, cq_ring_size_);
+            if (sq_ring_ != MAP_FAILED)
+                ::munmap(sq_ring_, sq_ring_size_);
+            if (fd_ >= 0)
+                ::close(fd_);
+        }
+
+        // false if io_uring is not available
+        bool open(unsigned entries)
+        {
+            io_uring_params params{};
+            fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd_ < 0)
+                return false;
+
+            sq_entries_ = params.sq_entries;
+            cq_entries_ = params.cq_entries;
+            sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+            if (params.features & IORING_FEAT_SINGLE_MMAP)
+                sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+
+            sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+            if (sq_ring_ == MAP_FAILED)
+                throw std::system_error{errno, std::system_category(), "mmap of the io_uring submission queue"};
+
+            cq_ring_ = (params.features & IORING_FEAT_SINGLE_MMAP)
+                ? sq_ring_
+                : ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+            if (cq_ring_ == MAP_FAILED)
+                throw std::system_error{errno, std::system_category(), "mmap of the io_uring completion queue"};
+
+            sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+            sqes_ = static_cast<io_uring_sqe*>(::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES));
+            if (sqes_ == MAP_FAILED)
+                throw std::system_error{errno, std::system_category(), "mmap of the io_uring submission entries"};
+
+            sq_head_ = at<unsigned>(sq_ring_, params.sq_off.head);
+            sq_tail_ = at<unsigned>(sq_ring_, params.sq_off.tail);
+            sq_mask_ = *at<unsigned>(sq_ring_, params.sq_off.ring_mask);
+            sq_array_ = at<unsigned>(sq_ring_, params.sq_off.array);
+            cq_head_ = at<unsigned>(cq_ring_, params.cq_off.head);
+            cq_tail_ = at<unsigned>(cq_ring_, params.cq_off.tail);
+            cq_mask_ = *at<unsigned>(cq_ring_, params.cq_off.ring_mask);
+            cqes_ = at<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+            return true;
+        }
+
+        int fd() const noexcept
+        {
+            return fd_;
+        }
+
+        unsigned cq_entries() const noexcept
+        {
+            return cq_entries_;
+        }
+
+        // Free submission entry (zeroed) or nullptr when the queue is full - published by push()
+        io_uring_sqe* next_sqe() noexcept
+        {
+            const auto tail = *sq_tail_; // written only by us
+            if (tail - load_acquire(sq_head_) == sq_entries_)
+                return nullptr;
+
+            auto* sqe = &sqes_[tail & sq_mask_];
+            std::memset(sqe, 0, sizeof(*sqe));
+            return sqe;
+        }
+
+        void push() noexcept
+        {
+            const auto tail = *sq_tail_;
+            sq_array_[tail & sq_mask_] = tail & sq_mask_;
+            store_release(sq_tail_, tail + 1);
+        }
+
+        int enter(unsigned to_submit, unsigned min_complete, unsigned flags) noexcept
+        {
+            const auto result = static_cast<int>(::syscall(__NR_io_uring_enter, fd_, to_submit, min_complete, flags, nullptr, 0));
+            return result < 0 ? -errno : result;
+        }
+
+        unsigned completion_tail() noexcept
+        {
+            return load_acquire(cq_tail_);
+        }
+
+        // Calls handler(user_data, result) for completions before tail - only the completion thread reads them
+        template <typename Handler>
+        void for_each_completion(unsigned tail, Handler handler)
+        {
+            auto head = *cq_head_;
+            while (head != tail)
+            {
+                const auto cqe = cqes_[head & cq_mask_];
+                store_release(cq_head_, ++head); // the entry can be reused by the kernel
+                handler(cqe.user_data, cqe.res);
+            }
+        }
+    };
+
+    // Fallback - pread/pwrite on a few blocking threads
+    class BlockingPool
+    {
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        OperationQueue queue_;
+        bool stop_ = false;
+        std::vector<std::jthread> threads_;
+
+        void run()
+        {
+            while (true)
+            {
+                std::unique_lock lk{mtx_};
+                cv_.wait(lk, [this] { return stop_ || !queue_.empty(); });
+                if (queue_.empty())
+                    return;
+                auto* op = queue_.pop();
+                lk.unlock();
+
+                const auto result = op->write ? ::pwrite(op->fd, op->buffer, op->length, static_cast<off_t>(op->offset))
+                                              : ::pread(op->fd, op->buffer, op->length, static_cast<off_t>(op->offset));
+                op->complete(op, result < 0 ? -errno : static_cast<int>(result));
+            }
+        }
+
+    public:
+        void start(std::size_t thread_count)
+        {
+            for (std::size_t i = 0; i < std::max<std::size_t>(thread_count, 1); ++i)
+                threads_.emplace_back([this] { run(); });
+        }
+
+        // Operations queued before destruction are executed
+        ~BlockingPool()
+        {
+            {
+                std::lock_guard lk{mtx_};
+                stop_ = true;
+            }
+            cv_.notify_all();
+            threads_.clear();
+        }
+
+        void post(IoOperation* op)
+        {
+            {
+                std::lock_guard lk{mtx_};
+                queue_.push(op);
+            }
+            cv_.notify_one();
+        }
+    };
+
+public:
+    explicit IoUringContext(IoBackend preferred = IoBackend::io_uring, unsigned entries = 256, std::size_t fallback_threads = 4)
+    {
+        if (preferred == IoBackend::io_uring && ring_.open(entries))
+        {
+            backend_ = IoBackend::io_uring;
+            completion_thread_ = std::jthread{[this] { run(); }};
+        }
+        else
+        {
+            backend_ = IoBackend::thread_pool;
+            fallback_.start(fallback_threads);
+        }
+    }
+
+    IoUringContext(const IoUringContext&) = delete;
+    IoUringContext& operator=(const IoUringContext&) = delete;
+
+    // Waits for started operations
+    ~IoUringContext()
+    {
+        if (backend_ != IoBackend::io_uring)
+            return;
+
+        {
+            std::lock_guard lk{mtx_};
+            stop_ = true;
+            // wakes up the completion thread - user_data 0
+            while (!ring_.next_sqe())
+                flush();
+            ring_.push();
+            ++unsubmitted_;
+            flush();
+        }
+        completion_thread_.join();
+    }
+
+    IoBackend backend() const noexcept
+    {
+        return backend_;
+    }
+
+    // Registers buffers for fixed-buffer reads and writes - has to be called before operations using them are started
+    void register_buffers(std::span<const std::span<std::byte>> buffers)
+    {
+        registered_.assign(buffers.begin(), buffers.end());
+        if (backend_ != IoBackend::io_uring)
+            return;
+
+        std::vector<iovec> iovecs;
+        for (auto buffer : buffers)
+            iovecs.push_back(iovec{buffer.data(), buffer.size()});
+
+        if (::syscall(__NR_io_uring_register, ring_.fd(), IORING_REGISTER_BUFFERS, iovecs.data(), static_cast<unsigned>(iovecs.size())) < 0)
+            throw std::system_error{errno, std::system_category(), "io_uring buffer registration"};
+    }
+
+    class ReadSomeSender;
+    class WriteSender;
+
+    // Sends the number of bytes read (0 at the end of the file) or a std::error_code
+    inline ReadSomeSender async_read_some(int fd, std::span<std::byte> buffer, std::uint64_t offset) noexcept;
+
+    // Writes the whole buffer (short writes are continued) - sends nothing or a std::error_code
+    inline WriteSender async_write(int fd, std::span<const std::byte> data, std::uint64_t offset) noexcept;
+
+private:
+    template <typename Receiver, bool Write>
+    class Operation : IoOperation
+    {
+        friend IoUringContext;
+
+        // a single read or write transfers at most INT_MAX bytes (the result is an int)
+        static constexpr std::size_t max_chunk = std::numeric_limits<int>::max();
+
+        IoUringContext& context_;
+        Receiver receiver_;
+        std::size_t remaining_; // bytes left to write - submitted in chunks of at most max_chunk
+
+        static void complete(IoOperation* base, int result) noexcept
+        {
+            auto& op = *static_cast<Operation*>(base);
+
+            if (result < 0 || (Write && result == 0 && op.length > 0))
+            {
+                stdexec::set_error(std::move(op.receiver_), std::error_code{result < 0 ? -result : EIO, std::system_category()});
+                return;
+            }
+
+            if constexpr (Write)
+            {
+                op.remaining_ -= static_cast<std::size_t>(result);
+                if (op.remaining_ > 0)
+                {
+                    op.buffer += result;
+                    op.offset += static_cast<std::uint64_t>(result);
+                    op.length = static_cast<unsigned>(std::min(op.remaining_, max_chunk));
+                    op.context_.submit(&op);
+                    return;
+                }
+                stdexec::set_value(std::move(op.receiver_));
+            }
+            else
+                stdexec::set_value(std::move(op.receiver_), static_cast<std::size_t>(result));
+        }
+
+    public:
+        using operation_state_concept = stdexec::operation_state_t;
+
+        Operation(IoUringContext& context, int fd, std::byte* buffer, std::size_t length, std::uint64_t offset, Receiver receiver)
+            : IoOperation{&complete, Write, fd, buffer, static_cast<unsigned>(std::min(length, max_chunk)), offset}
+            , context_{context}
+            , receiver_{std::move(receiver)}
+            , remaining_{length}
+        {
+            buffer_index = context.registered_index(buffer, length);
+        }
+
+        Operation(const Operation&) = delete;
+        Operation& operator=(const Operation&) = delete;
+
+        void start() & noexcept
+        {
+            context_.submit(this);
+        }
+    };
+
+    Ring ring_;
+    IoBackend backend_;
+    BlockingPool fallback_;
+    std::vector<std::span<std::byte>> registered_;
+
+    std::mutex mtx_;
+    unsigned unsubmitted_ = 0;  // entries pushed to the submission queue, not yet passed to io_uring_enter
+    unsigned in_flight_ = 0;    // limited to the size of the completion queue
+    OperationQueue backlog_;    // operations waiting for a free completion entry
+    bool stop_ = false;
+    std::jthread completion_thread_;
+
+    inline static thread_local const IoUringContext* completing_ = nullptr;
+
+    int registered_index(const std::byte* buffer, std::size_t length) const noexcept
+    {
+        for (std::size_t i = 0; i < registered_.size(); ++i)
+            if (buffer >= registered_[i].data() && buffer + length <= registered_[i].data() + registered_[i].size())
+                return static_cast<int>(i);
+        return -1;
+    }
+
+    // mtx_ has to be locked
+    void flush() noexcept
+    {
+        if (unsubmitted_ == 0)
+            return;
+
+        const auto submitted = ring_.enter(unsubmitted_, 0, 0);
+        if (submitted > 0)
+            unsubmitted_ -= static_cast<unsigned>(submitted);
+        // errors (EAGAIN, EBUSY) - the completion thread retries
+    }
+
+    // mtx_ has to be locked - false if the submission queue is full
+    bool push(IoOperation* op) noexcept
+    {
+        auto* sqe = ring_.next_sqe();
+        if (!sqe)
+        {
+            flush();
+            sqe = ring_.next_sqe();
+            if (!sqe)
+                return false;
+        }
+
+        if (op->buffer_index >= 0)
+            sqe->opcode = op->write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        else
+            sqe->opcode = op->write ? IORING_OP_WRITE : IORING_OP_READ;
+        sqe->fd = op->fd;
+        sqe->addr = reinterpret_cast<std::uint64_t>(op->buffer);
+        sqe->len = op->length;
+        sqe->off = op->offset;
+        sqe->buf_index = static_cast<std::uint16_t>(std::max(op->buffer_index, 0));
+        sqe->user_data = reinterpret_cast<std::uint64_t>(op);
+
+        ring_.push();
+        ++unsubmitted_;
+        ++in_flight_;
+        return true;
+    }
+
+    void submit(IoOperation* op)
+    {
+        if (backend_ != IoBackend::io_uring)
+        {
+            fallback_.post(op);
+            return;
+        }
+
+        std::lock_guard lk{mtx_};
+        if (in_flight_ == ring_.cq_entries() || !backlog_.empty() || !push(op))
+        {
+            backlog_.push(op);
+            return;
+        }
+
+        // the completion thread submits a whole batch before it waits for completions
+        if (completing_ != this)
+            flush();
+    }
+
+    void run()
+    {
+        completing_ = this;
+        bool stopping = false;
+
+        while (true)
+        {
+            unsigned to_submit;
+            {
+                std::lock_guard lk{mtx_};
+                if (stopping && in_flight_ == 0 && backlog_.empty())
+                    return;
+                to_submit = std::exchange(unsubmitted_, 0);
+            }
+
+            const auto submitted = ring_.enter(to_submit, 1, IORING_ENTER_GETEVENTS);
+            const auto tail = ring_.completion_tail();
+            {
+                // operations are pushed under the lock - locking it after their completions were observed
+                // makes the state written by the submitting threads visible here (the kernel in between isn't)
+                std::lock_guard lk{mtx_};
+                unsubmitted_ += to_submit - static_cast<unsigned>(std::clamp(submitted, 0, static_cast<int>(to_submit)));
+            }
+
+            unsigned completed = 0;
+            ring_.for_each_completion(tail, [&](std::uint64_t user_data, int result) {
+                if (user_data == 0)
+                {
+                    stopping = true;
+                    return;
+                }
+                ++completed;
+                auto* op = reinterpret_cast<IoOperation*>(user_data);
+                op->complete(op, result);
+            });
+
+            std::lock_guard lk{mtx_};
+            in_flight_ -= completed;
+            while (!backlog_.empty() && in_flight_ < ring_.cq_entries() && push(backlog_.head))
+                backlog_.pop();
+        }
+    }
+};
+
+class IoUringContext::ReadSomeSender
+{
+    IoUringContext* context_;
+    int fd_;
+    std::span<std::byte> buffer_;
+    std::uint64_t offset_;
+
+public:
+    using sender_concept = stdexec::sender_t;
+    using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t(std::size_t), stdexec::set_error_t(std::error_code)>;
+
+    ReadSomeSender(IoUringContext& context, int fd, std::span<std::byte> buffer, std::uint64_t offset) noexcept
+        : context_{&context}
+        , fd_{fd}
+        , buffer_{buffer}
+        , offset_{offset}
+    { }
+
+    template <stdexec::receiver Receiver>
+    Operation<Receiver, false> connect(Receiver receiver) const
+    {
+        return Operation<Receiver, false>{*context_, fd_, buffer_.data(), buffer_.size(), offset_, std::move(receiver)};
+    }
+};
+
+class IoUringContext::WriteSender
+{
+    IoUringContext* context_;
+    int fd_;
+    std::span<const std::byte> data_;
+    std::uint64_t offset_;
+
+public:
+    using sender_concept = stdexec::sender_t;
+    using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_error_t(std::error_code)>;
+
+    WriteSender(IoUringContext& context, int fd, std::span<const std::byte> data, std::uint64_t offset) noexcept
+        : context_{&context}
+        , fd_{fd}
+        , data_{data}
+        , offset_{offset}
+    { }
+
+    template <stdexec::receiver Receiver>
+    Operation<Receiver, true> connect(Receiver receiver) const
+    {
+        // the buffer is only read - IoOperation keeps a single pointer type for both directions
+        return Operation<Receiver, true>{*context_, fd_, const_cast<std::byte*>(data_.data()), data_.size(), offset_, std::move(receiver)};
+    }
+};
+
+inline IoUringContext::ReadSomeSender IoUringContext::async_read_some(int fd, std::span<std::byte> buffer, std::uint64_t offset) noexcept
+{
+    return ReadSomeSender{*this, fd, buffer, offset};
+}
+
+inline IoUringContext::WriteSender IoUringContext::async_write(int fd, std::span<const std::byte> data, std::uint64_t offset) noexcept
+{
+    return WriteSender{*this, fd, data, offset};
+}
+
+#endif
+
+#endif
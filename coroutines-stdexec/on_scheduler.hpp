@@ -0,0 +1,29 @@
+#ifndef ON_SCHEDULER_HPP
+#define ON_SCHEDULER_HPP
+
+#include <exec/static_thread_pool.hpp>
+#include <functional>
+#include <stdexec/execution.hpp>
+#include <utility>
+
+// co_await on(pool, func, args...) - calls func(args...) on a thread of the pool and sends its result.
+// Alternative to async_task (std::async): no thread is created and there is no shared state -
+// the callable, the arguments and the result live in the operation state, which exec::task keeps
+// in its coroutine frame. Arguments are decay-copied (as by std::async) and passed as rvalues.
+// Exceptions thrown by func are rethrown by co_await.
+template <stdexec::scheduler Scheduler, typename F, typename... Args>
+auto on(Scheduler scheduler, F&& func, Args&&... args)
+{
+    return stdexec::schedule(std::move(scheduler))
+        | stdexec::then([func = std::forward<F>(func), ... args = std::forward<Args>(args)]() mutable {
+              return std::invoke(std::move(func), std::move(args)...);
+          });
+}
+
+template <typename F, typename... Args>
+auto on(exec::static_thread_pool& pool, F&& func, Args&&... args)
+{
+    return on(pool.get_scheduler(), std::forward<F>(func), std::forward<Args>(args)...);
+}
+
+#endif
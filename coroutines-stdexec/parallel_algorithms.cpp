@@ -0,0 +1,129 @@
+#include "parallel_algorithms.hpp"
+
+#include <algorithm>
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <exec/static_thread_pool.hpp>
+#include <helpers.hpp>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexec/execution.hpp>
+#include <string>
+#include <vector>
+
+namespace
+{
+    long square(int n)
+    {
+        return static_cast<long>(n) * n;
+    }
+
+    bool is_even(int n)
+    {
+        return n % 2 == 0;
+    }
+
+    // values from create_numeric_dataset are in [-100, 100)
+    std::size_t bin_of(int n)
+    {
+        return static_cast<std::size_t>(n + 100) / 20;
+    }
+
+    constexpr std::size_t bin_count = 10;
+
+    std::vector<std::size_t> ranges_histogram(std::span<const int> data)
+    {
+        std::vector<std::size_t> bins(bin_count);
+        for (int n : data)
+            ++bins[bin_of(n)];
+        return bins;
+    }
+} // namespace
+
+TEST_CASE("parallel algorithms - results match std::ranges")
+{
+    exec::static_thread_pool pool{4};
+
+    // sizes not divisible by the chunk size, including empty and smaller than one chunk
+    for (std::size_t size : {0, 1, 100, 12'345, 1'000'003})
+    {
+        const auto data = helpers::create_numeric_dataset(size, 665);
+        const std::span<const int> input{data};
+
+        INFO("size: " << size);
+
+        std::vector<long> expected_squares(size);
+        std::ranges::transform(data, expected_squares.begin(), square);
+        std::vector<long> squares(size);
+        stdexec::sync_wait(parallel::transform(pool, input, std::span{squares}, square));
+        CHECK(squares == expected_squares);
+
+        auto [sum] = stdexec::sync_wait(parallel::reduce(pool, input, 0L)).value();
+        CHECK(sum == std::ranges::fold_left(data, 0L, std::plus<>{}));
+
+        std::vector<int> expected_evens;
+        std::ranges::copy_if(data, std::back_inserter(expected_evens), is_even);
+        std::vector<int> evens(size);
+        auto [count] = stdexec::sync_wait(parallel::filter(pool, input, std::span{evens}, is_even)).value();
+        evens.resize(count);
+        CHECK(evens == expected_evens); // stable
+
+        auto [bins] = stdexec::sync_wait(parallel::histogram(pool, input, bin_count, bin_of)).value();
+        CHECK(bins == ranges_histogram(input));
+    }
+}
+
+TEST_CASE("parallel algorithms - chunk plan")
+{
+    SECTION("chunks are multiples of a cache line and cover the input")
+    {
+        const parallel::ChunkPlan plan{1'000'003, 8, 2 * sizeof(int), sizeof(int)};
+
+        CHECK(plan.chunk_size % (parallel::cache_line_size / sizeof(int)) == 0);
+        CHECK(plan.count >= 4 * 8);
+        CHECK(plan.range(0).first == 0);
+        CHECK(plan.range(plan.count - 1).second == 1'000'003);
+    }
+
+    SECTION("chunk data fits in half of L2")
+    {
+        const parallel::ChunkPlan plan{1'000'000'000, 1, 2 * sizeof(int), sizeof(int)};
+
+        CHECK(plan.chunk_size * 2 * sizeof(int) <= parallel::l2_cache_size() / 2);
+    }
+}
+
+TEST_CASE("parallel algorithms benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+
+    exec::static_thread_pool pool;
+    std::cout << "threads: " << pool.available_parallelism() << ", L2: " << parallel::l2_cache_size() / 1024 << " KiB\n";
+
+    // 10^9 elements need 4 GB for the input and 8 GB for the transform output
+    for (std::size_t size : {1'000'000, 100'000'000})
+    {
+        std::cout << "--- " << size << " elements\n";
+
+        const auto data = helpers::create_numeric_dataset(size);
+        const std::span<const int> input{data};
+        const auto runs = size > 10'000'000 ? 3 : 10;
+
+        std::vector<long> squares(size);
+        bm::run("transform - std::ranges", size, [&] { std::ranges::transform(data, squares.begin(), square); }, runs);
+        bm::run("transform - bulk", size, [&] { stdexec::sync_wait(parallel::transform(pool, input, std::span{squares}, square)); }, runs);
+
+        bm::run("reduce - std::ranges::fold_left", size, [&] { bm::do_not_optimize(std::ranges::fold_left(data, 0L, std::plus<>{})); }, runs);
+        bm::run("reduce - bulk", size, [&] { bm::do_not_optimize(stdexec::sync_wait(parallel::reduce(pool, input, 0L))); }, runs);
+
+        std::vector<int> evens(size);
+        bm::run("filter - std::ranges::copy_if", size, [&] { bm::do_not_optimize(std::ranges::copy_if(data, evens.begin(), is_even)); }, runs);
+        bm::run("filter - bulk", size, [&] { bm::do_not_optimize(stdexec::sync_wait(parallel::filter(pool, input, std::span{evens}, is_even))); }, runs);
+
+        bm::run("histogram - loop", size, [&] { bm::do_not_optimize(ranges_histogram(input)); }, runs);
+        bm::run("histogram - bulk", size, [&] { bm::do_not_optimize(stdexec::sync_wait(parallel::histogram(pool, input, bin_count, bin_of))); }, runs);
+    }
+}
@@ -0,0 +1,150 @@
+#ifndef PARALLEL_ALGORITHMS_HPP
+#define PARALLEL_ALGORITHMS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exec/static_thread_pool.hpp>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <stdexec/execution.hpp>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+// Data-parallel algorithms built on stdexec::bulk - every algorithm returns a sender that runs
+// on an exec::static_thread_pool. Input is split into chunks; one bulk index processes one chunk.
+namespace parallel
+{
+    inline constexpr std::size_t cache_line_size = 64;
+
+    // Size of the L2 cache of the machine (1 MiB if unknown)
+    inline std::size_t l2_cache_size()
+    {
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE)
+        static const auto size = ::sysconf(_SC_LEVEL2_CACHE_SIZE);
+        if (size > 0)
+            return static_cast<std::size_t>(size);
+#endif
+        return std::size_t{1} << 20;
+    }
+
+    // Split of [0, size) into chunks:
+    //  - at least 4 chunks per thread - threads finishing early take over the remaining chunks
+    //  - the data touched by a chunk (bytes_per_element per element) fits in half of L2
+    //  - a chunk has at least 16 cache lines of output and its size is a multiple of a cache line
+    //    (threads writing neighbouring chunks of an aligned output never share a cache line)
+    struct ChunkPlan
+    {
+        std::size_t size = 0;
+        std::size_t chunk_size = 1;
+        std::size_t count = 0;
+
+        ChunkPlan(std::size_t size, std::size_t thread_count, std::size_t bytes_per_element, std::size_t output_element_size)
+            : size{size}
+        {
+            const auto line_elements = std::max<std::size_t>(cache_line_size / std::max<std::size_t>(output_element_size, 1), 1);
+            const auto min_chunk = 16 * line_elements;
+            const auto max_chunk = std::max(l2_cache_size() / 2 / std::max<std::size_t>(bytes_per_element, 1), min_chunk);
+            const auto min_chunk_count = 4 * std::max<std::size_t>(thread_count, 1);
+            const auto balanced = (size + min_chunk_count - 1) / min_chunk_count;
+
+            chunk_size = std::clamp(balanced, min_chunk, max_chunk);
+            chunk_size = (chunk_size + line_elements - 1) / line_elements * line_elements;
+            count = (size + chunk_size - 1) / chunk_size;
+        }
+
+        std::pair<std::size_t, std::size_t> range(std::size_t chunk) const noexcept
+        {
+            const auto first = chunk * chunk_size;
+            return {first, std::min(first + chunk_size, size)};
+        }
+    };
+
+    // output[i] = op(input[i]) - output.size() >= input.size()
+    template <typename T, typename U, typename Op>
+    auto transform(exec::static_thread_pool& pool, std::span<const T> input, std::span<U> output, Op op)
+    {
+        const ChunkPlan plan{input.size(), pool.available_parallelism(), sizeof(T) + sizeof(U), sizeof(U)};
+
+        return stdexec::schedule(pool.get_scheduler())
+            | stdexec::bulk(plan.count, [plan, input, output, op](std::size_t chunk) {
+                  const auto [first, last] = plan.range(chunk);
+                  std::transform(input.begin() + first, input.begin() + last, output.begin() + first, op);
+              });
+    }
+
+    // Reduction with an associative and commutative op - sends the result
+    template <typename T, typename Result, typename Op = std::plus<>>
+    auto reduce(exec::static_thread_pool& pool, std::span<const T> input, Result init, Op op = {})
+    {
+        const ChunkPlan plan{input.size(), pool.available_parallelism(), sizeof(T), sizeof(Result)};
+
+        return stdexec::schedule(pool.get_scheduler())
+            | stdexec::then([plan] { return std::vector<Result>(plan.count); })
+            | stdexec::bulk(plan.count, [plan, input, op](std::size_t chunk, std::vector<Result>& partials) {
+                  const auto [first, last] = plan.range(chunk);
+                  // the partial result is kept in a register - written once per chunk
+                  partials[chunk] = std::reduce(input.begin() + first + 1, input.begin() + last, Result(input[first]), op);
+              })
+            | stdexec::then([init, op](std::vector<Result> partials) {
+                  return std::reduce(partials.begin(), partials.end(), init, op);
+              });
+    }
+
+    // Stable copy of the elements satisfying pred to the beginning of output - sends the number of copied elements.
+    // Two passes: elements matching in each chunk are counted, then every chunk copies its elements to the
+    // offset given by the exclusive scan of the counts (the extra last offset is the total count).
+    template <typename T, typename Pred>
+    auto filter(exec::static_thread_pool& pool, std::span<const T> input, std::span<T> output, Pred pred)
+    {
+        const ChunkPlan plan{input.size(), pool.available_parallelism(), sizeof(T), sizeof(T)};
+
+        return stdexec::schedule(pool.get_scheduler())
+            | stdexec::then([plan] { return std::vector<std::size_t>(plan.count + 1); })
+            | stdexec::bulk(plan.count, [plan, input, pred](std::size_t chunk, std::vector<std::size_t>& counts) {
+                  const auto [first, last] = plan.range(chunk);
+                  counts[chunk] = static_cast<std::size_t>(std::count_if(input.begin() + first, input.begin() + last, pred));
+              })
+            | stdexec::then([](std::vector<std::size_t> counts) {
+                  std::exclusive_scan(counts.begin(), counts.end(), counts.begin(), std::size_t{0});
+                  return counts; // offsets
+              })
+            | stdexec::bulk(plan.count, [plan, input, output, pred](std::size_t chunk, std::vector<std::size_t>& offsets) {
+                  const auto [first, last] = plan.range(chunk);
+                  std::copy_if(input.begin() + first, input.begin() + last, output.begin() + offsets[chunk], pred);
+              })
+            | stdexec::then([](std::vector<std::size_t> offsets) { return offsets.back(); });
+    }
+
+    // Counts of elements per bin - bin_of(element) has to be in [0, bin_count); sends std::vector<std::size_t>.
+    // Every chunk fills its own histogram (no atomics, padded to whole cache lines), the histograms are
+    // summed at the end.
+    template <typename T, typename BinOf>
+    auto histogram(exec::static_thread_pool& pool, std::span<const T> input, std::size_t bin_count, BinOf bin_of)
+    {
+        const ChunkPlan plan{input.size(), pool.available_parallelism(), sizeof(T), sizeof(T)};
+        constexpr auto line_bins = cache_line_size / sizeof(std::size_t);
+        const auto stride = (bin_count + line_bins - 1) / line_bins * line_bins;
+
+        return stdexec::schedule(pool.get_scheduler())
+            | stdexec::then([plan, stride] { return std::vector<std::size_t>(plan.count * stride); })
+            | stdexec::bulk(plan.count, [plan, input, stride, bin_of](std::size_t chunk, std::vector<std::size_t>& local) {
+                  const auto [first, last] = plan.range(chunk);
+                  auto* bins = local.data() + chunk * stride;
+                  for (auto i = first; i < last; ++i)
+                      ++bins[bin_of(input[i])];
+              })
+            | stdexec::then([plan, bin_count, stride](std::vector<std::size_t> local) {
+                  std::vector<std::size_t> result(bin_count);
+                  for (std::size_t chunk = 0; chunk < plan.count; ++chunk)
+                      std::transform(result.begin(), result.end(), local.begin() + chunk * stride, result.begin(), std::plus<>{});
+                  return result;
+              });
+    }
+} // namespace parallel
+
+#endif
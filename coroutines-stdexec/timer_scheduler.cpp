@@ -0,0 +1,183 @@
+#include "timer_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <exec/task.hpp>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <stdexcept>
+#include <stdexec/execution.hpp>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace std::literals;
+
+// calculate_square from coroutines.cpp without pinning a thread for the delay
+exec::task<int> delayed_square(TimerScheduler::scheduler timer, int n, std::chrono::milliseconds delay)
+{
+    co_await timer.schedule_after(delay);
+    co_return n * n;
+}
+
+TEST_CASE("timer scheduler - delayed tasks wait concurrently")
+{
+    TimerScheduler timer;
+    const auto start = TimerScheduler::Clock::now();
+
+    auto [a, b] = stdexec::sync_wait(stdexec::when_all(
+        delayed_square(timer.get_scheduler(), 6, 200ms), delayed_square(timer.get_scheduler(), 7, 200ms))).value();
+
+    const auto elapsed = TimerScheduler::Clock::now() - start;
+
+    CHECK(a == 36);
+    CHECK(b == 49);
+    CHECK(elapsed >= 200ms);
+    CHECK(elapsed < 390ms);
+}
+
+// retry with exponential backoff - the delays don't block any thread
+exec::task<int> with_retries(TimerScheduler::scheduler timer, int failures, int& attempts)
+{
+    auto backoff = 1ms;
+    while (true)
+    {
+        try
+        {
+            if (++attempts <= failures)
+                throw std::runtime_error{"temporary failure"};
+            co_return attempts;
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+
+        co_await timer.schedule_after(backoff);
+        backoff *= 2;
+    }
+}
+
+TEST_CASE("timer scheduler - retry with backoff")
+{
+    TimerScheduler timer;
+    int attempts = 0;
+
+    auto [result] = stdexec::sync_wait(with_retries(timer.get_scheduler(), 3, attempts)).value();
+
+    CHECK(result == 4);
+    CHECK(attempts == 4);
+}
+
+TEST_CASE("timer scheduler - timers complete in the order of deadlines")
+{
+    constexpr int count = 1'000;
+
+    TimerScheduler timer;
+    const auto start = TimerScheduler::Clock::now() + 50ms;
+    std::vector<int> order;
+    std::latch done{count};
+
+    // registered in reverse order - deadlines spread over 10 ms, several timers share a deadline
+    for (int i = count - 1; i >= 0; --i)
+        stdexec::start_detached(timer.get_scheduler().schedule_at(start + (i / 4) * 40us) | stdexec::then([&order, &done, i] {
+            order.push_back(i / 4); // all timers complete on the timer thread
+            done.count_down();
+        }));
+
+    done.wait();
+
+    CHECK(order.size() == count);
+    CHECK(std::ranges::is_sorted(order));
+    CHECK(timer.pending() == 0);
+}
+
+TEST_CASE("timer scheduler - stop request cancels the timer")
+{
+    TimerScheduler timer;
+    const auto start = TimerScheduler::Clock::now();
+
+    // just_stopped() completes first - when_all requests stop of the timer
+    auto result = stdexec::sync_wait(stdexec::when_all(timer.get_scheduler().schedule_after(10s), stdexec::just_stopped()));
+
+    CHECK_FALSE(result.has_value());
+    CHECK(TimerScheduler::Clock::now() - start < 1s);
+    CHECK(timer.pending() == 0);
+}
+
+TEST_CASE("timer scheduler - deadline in the past completes immediately")
+{
+    TimerScheduler timer;
+
+    auto result = stdexec::sync_wait(timer.get_scheduler().schedule_at(TimerScheduler::Clock::now() - 1h) | stdexec::then([] { return 42; }));
+
+    CHECK(std::get<0>(result.value()) == 42);
+}
+
+namespace
+{
+    struct DelayResults
+    {
+        std::chrono::nanoseconds elapsed;
+        std::chrono::nanoseconds average_lateness;
+        std::size_t threads;
+    };
+
+    // `count` delayed operations with deadlines spread over 100 ms
+    template <typename StartDelayed>
+    DelayResults run_delayed(int count, StartDelayed start_delayed)
+    {
+        std::atomic<long long> lateness{0};
+        std::latch done{count};
+        const auto start = TimerScheduler::Clock::now();
+
+        for (int i = 0; i < count; ++i)
+        {
+            const auto deadline = start + 100ms + (i % 100) * 1ms;
+            start_delayed(deadline, [&lateness, &done, deadline] {
+                lateness += (TimerScheduler::Clock::now() - deadline).count();
+                done.count_down();
+            });
+        }
+
+        const auto threads = helpers::benchmark::os_thread_count();
+        done.wait();
+
+        return {TimerScheduler::Clock::now() - start, std::chrono::nanoseconds{lateness / count}, threads};
+    }
+
+    void print(const std::string& name, const DelayResults& results)
+    {
+        std::cout << std::left << std::setw(48) << name << std::right
+                  << std::setw(8) << std::chrono::duration_cast<std::chrono::milliseconds>(results.elapsed).count() << " ms total"
+                  << std::setw(10) << std::chrono::duration_cast<std::chrono::microseconds>(results.average_lateness).count() << " us late (avg)"
+                  << std::setw(8) << results.threads << " OS threads\n";
+    }
+} // namespace
+
+TEST_CASE("timer scheduler benchmark", "[.benchmark]")
+{
+    for (int count : {1'000, 10'000, 100'000})
+    {
+        std::cout << "--- " << count << " delayed operations\n";
+
+        if (count <= 10'000)
+        {
+            print("thread per delay (sleep_until)", run_delayed(count, [](auto deadline, auto on_expired) {
+                std::thread{[deadline, on_expired] {
+                    std::this_thread::sleep_until(deadline);
+                    on_expired();
+                }}.detach();
+            }));
+        }
+
+        TimerScheduler timer;
+        print("timer scheduler (timing wheel)", run_delayed(count, [&timer](auto deadline, auto on_expired) {
+            stdexec::start_detached(timer.get_scheduler().schedule_at(deadline) | stdexec::then(on_expired));
+        }));
+    }
+}
@@ -0,0 +1,296 @@
+#ifndef TIMER_SCHEDULER_HPP
+#define TIMER_SCHEDULER_HPP
+
+#include "timing_wheel.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <stdexec/execution.hpp>
+#include <thread>
+#include <utility>
+
+// Timer thread for stdexec pipelines - co_await timer.get_scheduler().schedule_after(1s) in an exec::task
+// suspends without blocking a thread. All pending timers share one thread:
+//  - timers are operation states linked into a coro::detail::TimingWheel (1 tick = 1 ns) - no allocations
+//  - the timer thread sleeps until the next expiry; receivers are completed on the timer thread
+//    (exec::task continues on its own scheduler afterwards)
+//  - a stop request removes the timer from the wheel and completes it with set_stopped
+class TimerScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class scheduler;
+
+    TimerScheduler()
+        : thread_{[this] { run(); }}
+    { }
+
+    TimerScheduler(const TimerScheduler&) = delete;
+    TimerScheduler& operator=(const TimerScheduler&) = delete;
+
+    // Timers pending at destruction are completed with set_stopped
+    ~TimerScheduler()
+    {
+        {
+            std::lock_guard lk{mtx_};
+            stop_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+
+        while (auto* timer = static_cast<OperationBase*>(wheel_.pop(std::numeric_limits<std::uint64_t>::max())))
+            timer->complete(timer, false);
+    }
+
+    inline scheduler get_scheduler() noexcept;
+
+    std::size_t pending() const
+    {
+        std::lock_guard lk{mtx_};
+        return wheel_.size();
+    }
+
+private:
+    struct OperationBase : coro::detail::TimerNode
+    {
+        enum class State
+        {
+            starting,
+            queued,
+            cancelled, // stop requested before add() - the operation is completed by start()
+            taken      // removed from the wheel by the timer thread or a stop request
+        };
+
+        void (*complete)(OperationBase*, bool expired) noexcept;
+        State state = State::starting; // guarded by mtx_
+    };
+
+    template <typename Receiver>
+    class Operation : OperationBase
+    {
+        friend TimerScheduler;
+
+        struct OnStop
+        {
+            Operation& op;
+
+            void operator()() const noexcept
+            {
+                if (op.timer_.cancel(&op))
+                    stdexec::set_stopped(std::move(op.receiver_)); // on_stop_ is destroyed with the operation
+            }
+        };
+
+        using StopToken = stdexec::stop_token_of_t<stdexec::env_of_t<Receiver>>;
+
+        TimerScheduler& timer_;
+        Clock::time_point deadline_;
+        Clock::duration delay_;
+        Receiver receiver_;
+        std::optional<stdexec::stop_callback_for_t<StopToken, OnStop>> on_stop_;
+
+        static void complete(OperationBase* base, bool expired) noexcept
+        {
+            auto& op = *static_cast<Operation*>(base);
+            op.on_stop_.reset(); // waits for a running OnStop - it can't remove the timer anymore
+            if (expired)
+                stdexec::set_value(std::move(op.receiver_));
+            else
+                stdexec::set_stopped(std::move(op.receiver_));
+        }
+
+    public:
+        using operation_state_concept = stdexec::operation_state_t;
+
+        Operation(TimerScheduler& timer, Clock::time_point deadline, Clock::duration delay, Receiver receiver)
+            : OperationBase{{}, &complete}
+            , timer_{timer}
+            , deadline_{deadline}
+            , delay_{delay}
+            , receiver_{std::move(receiver)}
+        { }
+
+        Operation(const Operation&) = delete;
+        Operation& operator=(const Operation&) = delete;
+
+        void start() & noexcept
+        {
+            auto token = stdexec::get_stop_token(stdexec::get_env(receiver_));
+            if (token.stop_requested())
+            {
+                stdexec::set_stopped(std::move(receiver_));
+                return;
+            }
+
+            const auto deadline = delay_ == Clock::duration::zero() ? deadline_ : Clock::now() + delay_;
+
+            if constexpr (stdexec::unstoppable_token<StopToken>)
+                timer_.add(this, deadline);
+            else
+            {
+                // registered first - a stop request arriving before add() marks the operation as cancelled.
+                // Once added, the operation can be completed (and destroyed) on another thread - `this`
+                // isn't touched after a successful add()
+                on_stop_.emplace(token, OnStop{*this});
+                if (!timer_.add(this, deadline))
+                    complete(this, false);
+            }
+        }
+    };
+
+    // Relative deadlines (schedule_after) are computed when the operation is started
+    class Sender
+    {
+        TimerScheduler* timer_;
+        Clock::time_point deadline_;
+        Clock::duration delay_;
+
+    public:
+        using sender_concept = stdexec::sender_t;
+        using completion_signatures = stdexec::completion_signatures<stdexec::set_value_t(), stdexec::set_stopped_t()>;
+
+        struct Env
+        {
+            TimerScheduler* timer;
+
+            inline scheduler query(stdexec::get_completion_scheduler_t<stdexec::set_value_t>) const noexcept;
+        };
+
+        Sender(TimerScheduler& timer, Clock::time_point deadline, Clock::duration delay) noexcept
+            : timer_{&timer}
+            , deadline_{deadline}
+            , delay_{delay}
+        { }
+
+        template <stdexec::receiver Receiver>
+        Operation<Receiver> connect(Receiver receiver) const
+        {
+            return Operation<Receiver>{*timer_, deadline_, delay_, std::move(receiver)};
+        }
+
+        Env get_env() const noexcept
+        {
+            return Env{timer_};
+        }
+    };
+
+    std::uint64_t ticks(Clock::time_point time) const noexcept
+    {
+        return time <= start_ ? 0 : static_cast<std::uint64_t>(std::chrono::nanoseconds{time - start_}.count());
+    }
+
+    // false if the timer was cancelled before it could be added
+    bool add(OperationBase* timer, Clock::time_point deadline)
+    {
+        const auto expiry = ticks(deadline);
+        bool earlier_than_wakeup;
+        {
+            std::lock_guard lk{mtx_};
+            if (timer->state == OperationBase::State::cancelled)
+                return false;
+            timer->expiry = expiry;
+            wheel_.insert(timer);
+            timer->state = OperationBase::State::queued;
+            earlier_than_wakeup = expiry < wakeup_at_;
+        }
+        if (earlier_than_wakeup)
+            cv_.notify_one();
+        return true;
+    }
+
+    // true if the caller has to complete the timer; false if it has already been taken by the timer thread
+    // or it hasn't been added yet (add() refuses it then)
+    bool cancel(OperationBase* timer)
+    {
+        std::lock_guard lk{mtx_};
+        switch (timer->state)
+        {
+        case OperationBase::State::queued:
+            wheel_.remove(timer);
+            timer->state = OperationBase::State::taken;
+            return true;
+        case OperationBase::State::starting:
+            timer->state = OperationBase::State::cancelled;
+            return false;
+        default:
+            return false;
+        }
+    }
+
+    void run()
+    {
+        std::unique_lock lk{mtx_};
+        while (!stop_)
+        {
+            const auto now = ticks(Clock::now());
+            while (auto* timer = static_cast<OperationBase*>(wheel_.pop(now)))
+            {
+                timer->state = OperationBase::State::taken;
+                lk.unlock();
+                timer->complete(timer, true);
+                lk.lock();
+            }
+
+            wakeup_at_ = wheel_.next_expiry();
+            if (wakeup_at_ == std::numeric_limits<std::uint64_t>::max())
+                cv_.wait(lk);
+            else
+                cv_.wait_until(lk, start_ + std::chrono::nanoseconds{wakeup_at_});
+        }
+    }
+
+    const Clock::time_point start_ = Clock::now();
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    coro::detail::TimingWheel wheel_;
+    std::uint64_t wakeup_at_ = std::numeric_limits<std::uint64_t>::max();
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+class TimerScheduler::scheduler
+{
+    TimerScheduler* timer_;
+
+public:
+    using scheduler_concept = stdexec::scheduler_t;
+
+    explicit scheduler(TimerScheduler& timer) noexcept
+        : timer_{&timer}
+    { }
+
+    Sender schedule() const noexcept
+    {
+        return Sender{*timer_, Clock::time_point{}, Clock::duration::zero()};
+    }
+
+    Sender schedule_at(Clock::time_point deadline) const noexcept
+    {
+        return Sender{*timer_, deadline, Clock::duration::zero()};
+    }
+
+    Sender schedule_after(Clock::duration delay) const noexcept
+    {
+        return Sender{*timer_, Clock::time_point{}, delay};
+    }
+
+    bool operator==(const scheduler&) const noexcept = default;
+};
+
+inline TimerScheduler::scheduler TimerScheduler::get_scheduler() noexcept
+{
+    return scheduler{*this};
+}
+
+inline TimerScheduler::scheduler TimerScheduler::Sender::Env::query(stdexec::get_completion_scheduler_t<stdexec::set_value_t>) const noexcept
+{
+    return scheduler{*timer};
+}
+
+#endif
@@ -0,0 +1,231 @@
+#include "async_generator.hpp"
+#include "channel.hpp"
+#include "detached_task.hpp"
+#include "work_stealing_scheduler.hpp"
+
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <latch>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+coro::async_generator<int> async_iota(int start, int end)
+{
+    for (int i = start; i < end; ++i)
+        co_yield i;
+}
+
+TEST_CASE("async generator - ready elements are consumed without suspension")
+{
+    std::vector<int> values;
+    bool finished = false;
+
+    [&]() -> coro::detached_task {
+        auto gen = async_iota(1, 6);
+        while (const int* value = co_await gen.next())
+            values.push_back(*value);
+        finished = true;
+    }();
+
+    CHECK(finished); // the consumer never suspended
+    CHECK(values == std::vector{1, 2, 3, 4, 5});
+
+    SECTION("iterators")
+    {
+        std::vector<int> values;
+
+        [&]() -> coro::detached_task {
+            auto gen = async_iota(1, 4);
+            for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it)
+                values.push_back(*it);
+        }();
+
+        CHECK(values == std::vector{1, 2, 3});
+    }
+}
+
+// producer suspends until a value arrives to the channel
+coro::async_generator<std::string> lines_from(coro::channel<std::string>& ch)
+{
+    while (auto line = co_await ch.receive())
+        co_yield "> " + *line;
+}
+
+// consumers that suspend can't be lambdas - captures would dangle after the first suspension
+coro::detached_task collect(coro::async_generator<std::string> gen, std::vector<std::string>& received, bool& finished)
+{
+    for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it)
+        received.push_back(*it);
+    finished = true;
+}
+
+TEST_CASE("async generator - producer awaits between yields")
+{
+    coro::channel<std::string> ch{4};
+    std::vector<std::string> received;
+    bool finished = false;
+
+    collect(lines_from(ch), received, finished);
+
+    CHECK(received.empty());
+
+    std::string line = "a";
+    ch.try_send(line); // resumes the producer which resumes the consumer
+    CHECK(received == std::vector<std::string>{"> a"});
+
+    line = "b";
+    ch.try_send(line);
+    CHECK_FALSE(finished);
+
+    ch.close();
+    CHECK(finished);
+    CHECK(received == std::vector<std::string>{"> a", "> b"});
+}
+
+coro::async_generator<int> failing_after(int count)
+{
+    for (int i = 0; i < count; ++i)
+        co_yield i;
+    throw std::runtime_error{"source failed"};
+}
+
+TEST_CASE("async generator - exception is rethrown to the consumer")
+{
+    int consumed = 0;
+    std::string error;
+
+    [&]() -> coro::detached_task {
+        auto gen = failing_after(2);
+        try
+        {
+            while (co_await gen.next())
+                ++consumed;
+        }
+        catch (const std::runtime_error& e)
+        {
+            error = e.what();
+        }
+    }();
+
+    CHECK(consumed == 2);
+    CHECK(error == "source failed");
+}
+
+coro::async_generator<int> values_from(coro::channel<int>& ch)
+{
+    while (auto value = co_await ch.receive())
+        co_yield *value;
+}
+
+coro::detached_task collect_odd_squares(coro::async_generator<std::span<const int>> batches, std::vector<std::vector<int>>& results, bool& finished)
+{
+    while (auto* batch = co_await batches.next())
+    {
+        auto odd_squares = *batch | std::views::filter([](int n) { return n % 2 == 1; }) | std::views::transform([](int n) { return n * n; });
+        results.emplace_back(odd_squares.begin(), odd_squares.end());
+    }
+    finished = true;
+}
+
+TEST_CASE("async generator - batches of ready elements")
+{
+    coro::channel<int> ch{8};
+    for (int i = 1; i <= 5; ++i)
+        ch.try_send(i);
+
+    std::vector<std::vector<int>> batches;
+    bool finished = false;
+
+    collect_odd_squares(coro::batched(values_from(ch), 4), batches, finished);
+
+    // 5 buffered values: full batch + the rest before the producer has to suspend
+    CHECK(batches == std::vector<std::vector<int>>{{1, 9}, {25}});
+
+    int value = 7;
+    ch.try_send(value);
+    CHECK(batches.size() == 3);
+    CHECK(batches.back() == std::vector{49});
+
+    ch.close();
+    CHECK(finished);
+}
+
+coro::async_generator<long> numbers_on_pool(coro::WorkStealingScheduler& pool, long count)
+{
+    for (long i = 1; i <= count; ++i)
+    {
+        if (i % 100 == 0)
+            co_await pool.schedule(); // continues on a worker thread
+        co_yield i;
+    }
+}
+
+coro::detached_task sum_elements(coro::async_generator<long> gen, long& sum, std::latch& done)
+{
+    while (const long* value = co_await gen.next())
+        sum += *value;
+    done.count_down();
+}
+
+coro::detached_task sum_batches(coro::async_generator<std::span<const long>> batches, long& sum, std::latch& done)
+{
+    while (auto* batch = co_await batches.next())
+        for (long value : *batch)
+            sum += value;
+    done.count_down();
+}
+
+TEST_CASE("async generator - producer hops between threads")
+{
+    constexpr long count = 10'000;
+
+    coro::WorkStealingScheduler pool{2};
+    std::latch done{2};
+    long sum = 0;
+    long batched_sum = 0;
+
+    sum_elements(numbers_on_pool(pool, count), sum, done);
+    sum_batches(coro::batched(numbers_on_pool(pool, count), 64), batched_sum, done);
+
+    done.wait();
+
+    CHECK(sum == count * (count + 1) / 2);
+    CHECK(batched_sum == count * (count + 1) / 2);
+}
+
+TEST_CASE("async generator benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+
+    constexpr int count = 1'000'000;
+    auto is_even = [](int n) { return n % 2 == 0; };
+    auto square = [](int n) { return static_cast<long>(n) * n; };
+
+    bm::run("async generator - element by element", count, [&] {
+        [&]() -> coro::detached_task {
+            long sum = 0;
+            auto gen = async_iota(0, count);
+            while (const int* value = co_await gen.next())
+                if (is_even(*value))
+                    sum += square(*value);
+            bm::do_not_optimize(sum);
+        }();
+    });
+
+    for (std::size_t batch_size : {64, 1024})
+    {
+        bm::run("async generator - batches of " + std::to_string(batch_size) + " + views", count, [&] {
+            [&]() -> coro::detached_task {
+                long sum = 0;
+                auto batches = coro::batched(async_iota(0, count), batch_size);
+                while (auto* batch = co_await batches.next())
+                    for (long value : *batch | std::views::filter(is_even) | std::views::transform(square))
+                        sum += value;
+                bm::do_not_optimize(sum);
+            }();
+        });
+    }
+}
@@ -0,0 +1,333 @@
+#ifndef ASYNC_GENERATOR_HPP
+#define ASYNC_GENERATOR_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace coro
+{
+    // Lazy sequence produced by a coroutine that may co_await (e.g. hop to a thread pool,
+    // wait for I/O) between its co_yields. Consumed from another coroutine:
+    //   while (const T* value = co_await gen.next())
+    //       use(*value);
+    // or with iterators (for co_await style):
+    //   for (auto it = co_await gen.begin(); it != gen.end(); co_await ++it)
+    //       use(*it);
+    // The producer is resumed inline by the consumer - if it yields without suspending
+    // on anything else, the consumer doesn't suspend at all. If the producer suspends
+    // on another awaitable, the consumer is suspended and resumed from the producer's
+    // next co_yield (possibly on another thread).
+    // The generator must not be destroyed while an element is being produced.
+    template <typename T>
+    class async_generator
+    {
+    public:
+        struct promise_type;
+        using CoroHandle = std::coroutine_handle<promise_type>;
+
+        enum class State
+        {
+            suspended, // producer suspended at co_yield (or not started yet)
+            running,   // producer resumed, no consumer waiting
+            waiting    // producer running asynchronously, consumer suspended
+        };
+
+        struct promise_type
+        {
+            const T* value_ = nullptr;
+            std::exception_ptr exception_;
+            std::atomic<State> state_{State::suspended};
+            std::coroutine_handle<> consumer_;
+
+            async_generator get_return_object() noexcept
+            {
+                return async_generator{CoroHandle::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            // hands the control back to the consumer - a waiting consumer is resumed with
+            // symmetric transfer, a consumer that resumed the producer inline just regains control
+            struct YieldAwaiter
+            {
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(CoroHandle coro) noexcept
+                {
+                    auto& promise = coro.promise();
+
+                    // after the exchange the frame may already be resumed by a consumer that didn't wait
+                    if (promise.state_.exchange(State::suspended, std::memory_order_acq_rel) == State::waiting)
+                        return promise.consumer_;
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() noexcept
+                { }
+            };
+
+            YieldAwaiter yield_value(const T& value) noexcept
+            {
+                value_ = std::addressof(value);
+                return {};
+            }
+
+            YieldAwaiter final_suspend() noexcept
+            {
+                value_ = nullptr;
+                return {};
+            }
+
+            void return_void() noexcept
+            { }
+
+            void unhandled_exception() noexcept
+            {
+                exception_ = std::current_exception();
+            }
+        };
+
+        async_generator() = default;
+
+        async_generator(async_generator&& other) noexcept
+            : coro_hndl_{std::exchange(other.coro_hndl_, {})}
+            , pending_{other.pending_}
+        { }
+
+        async_generator& operator=(async_generator&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (coro_hndl_)
+                    coro_hndl_.destroy();
+                coro_hndl_ = std::exchange(other.coro_hndl_, {});
+                pending_ = other.pending_;
+            }
+            return *this;
+        }
+
+        ~async_generator()
+        {
+            if (coro_hndl_)
+                coro_hndl_.destroy();
+        }
+
+        // Resumes the producer inline. Returns true if the next element (or the end of the sequence)
+        // is available in current() - false if the producer is still running asynchronously,
+        // then the element has to be awaited with next().
+        bool try_advance()
+        {
+            if (!coro_hndl_ || coro_hndl_.done())
+                return true;
+
+            auto& promise = coro_hndl_.promise();
+            promise.state_.store(State::running, std::memory_order_relaxed);
+            coro_hndl_.resume();
+
+            pending_ = promise.state_.load(std::memory_order_acquire) != State::suspended;
+            if (!pending_)
+                rethrow_if_failed();
+
+            return !pending_;
+        }
+
+        // Current element - nullptr at the end of the sequence
+        const T* current() const noexcept
+        {
+            return coro_hndl_ ? coro_hndl_.promise().value_ : nullptr;
+        }
+
+        // co_await next() - pointer to the next element or nullptr at the end of the sequence
+        auto next() noexcept
+        {
+            struct NextAwaiter
+            {
+                async_generator& gen;
+
+                bool await_ready()
+                {
+                    if (!gen.pending_)
+                        return gen.try_advance();
+
+                    return gen.coro_hndl_.promise().state_.load(std::memory_order_acquire) == State::suspended;
+                }
+
+                bool await_suspend(std::coroutine_handle<> consumer) noexcept
+                {
+                    auto& promise = gen.coro_hndl_.promise();
+                    promise.consumer_ = consumer;
+
+                    auto expected = State::running;
+                    return promise.state_.compare_exchange_strong(expected, State::waiting, std::memory_order_acq_rel);
+                }
+
+                const T* await_resume()
+                {
+                    if (gen.pending_)
+                    {
+                        gen.pending_ = false;
+                        gen.rethrow_if_failed();
+                    }
+                    return gen.current();
+                }
+            };
+
+            return NextAwaiter{*this};
+        }
+
+        class iterator
+        {
+            async_generator* gen_ = nullptr;
+
+        public:
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            explicit iterator(async_generator& gen) noexcept
+                : gen_{&gen}
+            { }
+
+            const T& operator*() const noexcept
+            {
+                return *gen_->current();
+            }
+
+            const T* operator->() const noexcept
+            {
+                return gen_->current();
+            }
+
+            // co_await ++it
+            auto operator++() noexcept
+            {
+                struct IncrementAwaiter
+                {
+                    iterator& it;
+                    decltype(std::declval<async_generator&>().next()) next;
+
+                    bool await_ready()
+                    {
+                        return next.await_ready();
+                    }
+
+                    bool await_suspend(std::coroutine_handle<> consumer) noexcept
+                    {
+                        return next.await_suspend(consumer);
+                    }
+
+                    iterator& await_resume()
+                    {
+                        next.await_resume();
+                        return it;
+                    }
+                };
+
+                return IncrementAwaiter{*this, gen_->next()};
+            }
+
+            bool operator==(std::default_sentinel_t) const noexcept
+            {
+                return gen_ == nullptr || gen_->current() == nullptr;
+            }
+        };
+
+        // co_await begin()
+        auto begin() noexcept
+        {
+            struct BeginAwaiter
+            {
+                async_generator& gen;
+                decltype(std::declval<async_generator&>().next()) next;
+
+                bool await_ready()
+                {
+                    return next.await_ready();
+                }
+
+                bool await_suspend(std::coroutine_handle<> consumer) noexcept
+                {
+                    return next.await_suspend(consumer);
+                }
+
+                iterator await_resume()
+                {
+                    next.await_resume();
+                    return iterator{gen};
+                }
+            };
+
+            return BeginAwaiter{*this, next()};
+        }
+
+        std::default_sentinel_t end() const noexcept
+        {
+            return std::default_sentinel;
+        }
+
+    private:
+        CoroHandle coro_hndl_;
+        bool pending_ = false; // producer resumed by try_advance() hasn't yielded yet
+
+        explicit async_generator(CoroHandle coro_hndl) noexcept
+            : coro_hndl_{coro_hndl}
+        { }
+
+        void rethrow_if_failed()
+        {
+            if (auto& exception = coro_hndl_.promise().exception_)
+                std::rethrow_exception(std::exchange(exception, nullptr));
+        }
+    };
+
+    // Groups elements of an async generator into batches (at most max_batch_size elements).
+    // A batch is yielded as soon as the source would have to suspend - so ready elements
+    // can be processed with range algorithms and views without per-element suspension:
+    //   while (auto* batch = co_await batches.next())
+    //       for (auto value : *batch | std::views::filter(pred)) ...
+    template <typename T>
+    async_generator<std::span<const T>> batched(async_generator<T> source, std::size_t max_batch_size)
+    {
+        std::vector<T> batch;
+        batch.reserve(max_batch_size);
+
+        while (const T* value = co_await source.next())
+        {
+            batch.push_back(*value);
+
+            bool finished = false;
+            while (batch.size() < max_batch_size && source.try_advance())
+            {
+                value = source.current();
+                if (!value)
+                {
+                    finished = true;
+                    break;
+                }
+                batch.push_back(*value);
+            }
+
+            co_yield std::span<const T>{batch};
+            batch.clear();
+
+            if (finished)
+                break;
+        }
+    }
+} // namespace coro
+
+#endif
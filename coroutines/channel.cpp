@@ -0,0 +1,118 @@
+#include "channel.hpp"
+#include "detached_task.hpp"
+#include "work_stealing_scheduler.hpp"
+
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <latch>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+TEST_CASE("channel - non-blocking operations")
+{
+    coro::channel<std::unique_ptr<int>> ch{3};
+
+    CHECK(ch.capacity() == 4);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        auto value = std::make_unique<int>(i);
+        CHECK(ch.try_send(value));
+        CHECK(value == nullptr);
+    }
+
+    auto rejected = std::make_unique<int>(42);
+    CHECK_FALSE(ch.try_send(rejected));
+    CHECK(*rejected == 42); // left intact
+
+    for (int i = 0; i < 4; ++i)
+        CHECK(**ch.try_receive() == i);
+
+    CHECK(ch.try_receive() == std::nullopt);
+}
+
+coro::detached_task produce(coro::channel<int>& ch, int count, std::vector<std::string>& log)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        co_await ch.send(i);
+        log.push_back("sent " + std::to_string(i));
+    }
+    ch.close();
+}
+
+coro::detached_task consume(coro::channel<int>& ch, std::vector<int>& received)
+{
+    while (auto value = co_await ch.receive())
+        received.push_back(*value);
+}
+
+TEST_CASE("channel - backpressure between coroutines")
+{
+    coro::channel<int> ch{2};
+    std::vector<std::string> log;
+    std::vector<int> received;
+
+    produce(ch, 5, log); // suspends when the channel is full
+    CHECK(log == std::vector<std::string>{"sent 0", "sent 1"});
+
+    consume(ch, received); // resumes the producer, finishes when the channel is closed
+
+    CHECK(log.size() == 5);
+    CHECK(received == std::vector{0, 1, 2, 3, 4});
+
+    SECTION("send to closed channel fails")
+    {
+        bool sent = true;
+        [&]() -> coro::detached_task { sent = co_await ch.send(5); }();
+
+        CHECK_FALSE(sent);
+    }
+}
+
+coro::detached_task pool_producer(coro::WorkStealingScheduler& pool, coro::channel<long>& ch, int count, std::atomic<int>& producers_left)
+{
+    co_await pool.schedule();
+
+    for (int i = 1; i <= count; ++i)
+        co_await ch.send(i);
+
+    if (producers_left.fetch_sub(1) == 1)
+        ch.close();
+}
+
+coro::detached_task pool_consumer(coro::WorkStealingScheduler& pool, coro::channel<long>& ch, std::atomic<long>& sum, std::latch& done)
+{
+    co_await pool.schedule();
+
+    long local_sum = 0;
+    while (auto value = co_await ch.receive())
+        local_sum += *value;
+
+    sum += local_sum;
+    done.count_down();
+}
+
+TEST_CASE("channel - MPMC on a thread pool")
+{
+    constexpr int producer_count = 4;
+    constexpr int consumer_count = 4;
+    constexpr int count = 10'000;
+
+    coro::channel<long> ch{16};
+    coro::WorkStealingScheduler pool{4}; // joined before the channel is destroyed
+    std::atomic<int> producers_left{producer_count};
+    std::atomic<long> sum{0};
+    std::latch done{consumer_count};
+
+    for (int i = 0; i < consumer_count; ++i)
+        pool_consumer(pool, ch, sum, done);
+    for (int i = 0; i < producer_count; ++i)
+        pool_producer(pool, ch, count, producers_left);
+
+    done.wait();
+
+    CHECK(sum == producer_count * (count * (count + 1L) / 2));
+}
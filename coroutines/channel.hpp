@@ -0,0 +1,390 @@
+#ifndef CHANNEL_HPP
+#define CHANNEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace coro
+{
+    // Bounded MPMC channel connecting coroutines:
+    //   co_await ch.send(value) - suspends while the channel is full (false if the channel is closed)
+    //   co_await ch.receive()   - suspends while the channel is empty (std::nullopt if closed and drained)
+    // Values are stored in a Vyukov bounded ring - send/receive that don't have to wait are lock-free.
+    // The waiter lists are locked only when a coroutine has to suspend or a waiter has to be woken.
+    // Woken coroutines are resumed on the thread that completed their operation.
+    // Awaiters take std::coroutine_handle<> - any coroutine type can use the channel.
+    template <typename T>
+    class channel
+    {
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence;
+            alignas(T) std::byte storage[sizeof(T)];
+        };
+
+        struct Waiter
+        {
+            std::coroutine_handle<> coro;
+            Waiter* next = nullptr;
+        };
+
+        // intrusive FIFO of suspended coroutines
+        struct WaiterQueue
+        {
+            Waiter* head = nullptr;
+            Waiter* tail = nullptr;
+
+            bool empty() const noexcept
+            {
+                return head == nullptr;
+            }
+
+            void push(Waiter* waiter) noexcept
+            {
+                waiter->next = nullptr;
+                (tail ? tail->next : head) = waiter;
+                tail = waiter;
+            }
+
+            Waiter* pop() noexcept
+            {
+                Waiter* waiter = head;
+                head = head->next;
+                if (!head)
+                    tail = nullptr;
+                return waiter;
+            }
+        };
+
+    public:
+        class SendAwaiter : Waiter
+        {
+            friend channel;
+
+            channel& channel_;
+            T value_;
+            bool sent_ = false;
+
+        public:
+            SendAwaiter(channel& ch, T value)
+                : channel_{ch}
+                , value_{std::move(value)}
+            { }
+
+            bool await_ready()
+            {
+                sent_ = channel_.try_send(value_);
+                return sent_;
+            }
+
+            bool await_suspend(std::coroutine_handle<> coro)
+            {
+                this->coro = coro;
+                return channel_.park_sender(*this);
+            }
+
+            bool await_resume() const noexcept
+            {
+                return sent_;
+            }
+        };
+
+        class ReceiveAwaiter : Waiter
+        {
+            friend channel;
+
+            channel& channel_;
+            std::optional<T> result_;
+
+        public:
+            explicit ReceiveAwaiter(channel& ch)
+                : channel_{ch}
+            { }
+
+            bool await_ready()
+            {
+                result_ = channel_.try_receive();
+                return result_.has_value();
+            }
+
+            bool await_suspend(std::coroutine_handle<> coro)
+            {
+                this->coro = coro;
+                return channel_.park_receiver(*this);
+            }
+
+            std::optional<T> await_resume() noexcept(std::is_nothrow_move_constructible_v<T>)
+            {
+                return std::move(result_);
+            }
+        };
+
+        explicit channel(std::size_t capacity)
+            : mask_{std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1}
+            , cells_{std::make_unique<Cell[]>(mask_ + 1)}
+        {
+            for (std::size_t i = 0; i <= mask_; ++i)
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        channel(const channel&) = delete;
+        channel& operator=(const channel&) = delete;
+
+        ~channel()
+        {
+            while (pop())
+            { }
+        }
+
+        std::size_t capacity() const noexcept
+        {
+            return mask_ + 1;
+        }
+
+        SendAwaiter send(T value)
+        {
+            return SendAwaiter{*this, std::move(value)};
+        }
+
+        ReceiveAwaiter receive()
+        {
+            return ReceiveAwaiter{*this};
+        }
+
+        // Moves the value into the channel if there is space - the value is left intact otherwise
+        bool try_send(T& value)
+        {
+            if (closed_.load(std::memory_order_acquire) || !push(value))
+                return false;
+
+            wake_receivers();
+            return true;
+        }
+
+        std::optional<T> try_receive()
+        {
+            auto value = pop();
+            if (value)
+                wake_senders();
+            return value;
+        }
+
+        // Suspended senders complete with false, receivers drain the remaining values
+        void close()
+        {
+            WaiterQueue senders;
+            WaiterQueue receivers;
+            {
+                std::lock_guard lk{waiters_mtx_};
+                closed_.store(true, std::memory_order_release);
+                std::swap(senders, senders_);
+                std::swap(receivers, receivers_);
+                waiting_senders_.store(0, std::memory_order_relaxed);
+                waiting_receivers_.store(0, std::memory_order_relaxed);
+            }
+
+            resume_all(senders);
+            resume_all(receivers);
+        }
+
+        bool is_closed() const noexcept
+        {
+            return closed_.load(std::memory_order_acquire);
+        }
+
+    private:
+        static constexpr std::size_t cache_line_size = 64;
+
+        const std::size_t mask_;
+        std::unique_ptr<Cell[]> cells_;
+        alignas(cache_line_size) std::atomic<std::size_t> enqueue_pos_{0};
+        alignas(cache_line_size) std::atomic<std::size_t> dequeue_pos_{0};
+        alignas(cache_line_size) std::atomic<std::size_t> waiting_senders_{0};
+        std::atomic<std::size_t> waiting_receivers_{0};
+        std::atomic<bool> closed_{false};
+        std::mutex waiters_mtx_;
+        WaiterQueue senders_;
+        WaiterQueue receivers_;
+
+        bool push(T& value)
+        {
+            auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                Cell& cell = cells_[pos & mask_];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+                if (diff == 0)
+                {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        ::new (cell.storage) T(std::move(value));
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                    return false; // full
+                else
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        std::optional<T> pop()
+        {
+            auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+            while (true)
+            {
+                Cell& cell = cells_[pos & mask_];
+                const auto sequence = cell.sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+
+                if (diff == 0)
+                {
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        T* item = std::launder(reinterpret_cast<T*>(cell.storage));
+                        std::optional<T> value{std::move(*item)};
+                        item->~T();
+                        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                        return value;
+                    }
+                }
+                else if (diff < 0)
+                    return std::nullopt; // empty
+                else
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        // Slow path of send - false if the operation completed while registering the waiter
+        bool park_sender(SendAwaiter& awaiter)
+        {
+            {
+                std::lock_guard lk{waiters_mtx_};
+
+                waiting_senders_.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (!closed_.load(std::memory_order_relaxed) && !push(awaiter.value_))
+                {
+                    senders_.push(&awaiter);
+                    return true;
+                }
+
+                waiting_senders_.fetch_sub(1);
+                awaiter.sent_ = !closed_.load(std::memory_order_relaxed);
+            }
+
+            if (awaiter.sent_)
+                wake_receivers();
+            return false;
+        }
+
+        bool park_receiver(ReceiveAwaiter& awaiter)
+        {
+            {
+                std::lock_guard lk{waiters_mtx_};
+
+                waiting_receivers_.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                awaiter.result_ = pop();
+                if (!awaiter.result_ && !closed_.load(std::memory_order_relaxed))
+                {
+                    receivers_.push(&awaiter);
+                    return true;
+                }
+
+                waiting_receivers_.fetch_sub(1);
+            }
+
+            if (awaiter.result_)
+                wake_senders();
+            return false;
+        }
+
+        // Completes pending receive operations with values from the ring
+        void wake_receivers()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting_receivers_.load(std::memory_order_relaxed) == 0)
+                return;
+
+            WaiterQueue ready;
+            {
+                std::lock_guard lk{waiters_mtx_};
+
+                while (!receivers_.empty())
+                {
+                    auto value = pop();
+                    if (!value)
+                        break;
+
+                    auto* awaiter = static_cast<ReceiveAwaiter*>(receivers_.pop());
+                    awaiter->result_ = std::move(value);
+                    waiting_receivers_.fetch_sub(1, std::memory_order_relaxed);
+                    ready.push(awaiter);
+                }
+            }
+
+            if (!ready.empty())
+            {
+                wake_senders(); // values were taken from the ring
+                resume_all(ready);
+            }
+        }
+
+        // Completes pending send operations while there is space in the ring
+        void wake_senders()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting_senders_.load(std::memory_order_relaxed) == 0)
+                return;
+
+            WaiterQueue ready;
+            {
+                std::lock_guard lk{waiters_mtx_};
+
+                while (!senders_.empty())
+                {
+                    auto* awaiter = static_cast<SendAwaiter*>(senders_.head);
+                    if (!push(awaiter->value_))
+                        break;
+
+                    senders_.pop();
+                    awaiter->sent_ = true;
+                    waiting_senders_.fetch_sub(1, std::memory_order_relaxed);
+                    ready.push(awaiter);
+                }
+            }
+
+            if (!ready.empty())
+            {
+                wake_receivers(); // values were added to the ring
+                resume_all(ready);
+            }
+        }
+
+        static void resume_all(WaiterQueue& waiters)
+        {
+            while (!waiters.empty())
+                waiters.pop()->coro.resume();
+        }
+    };
+} // namespace coro
+
+#endif
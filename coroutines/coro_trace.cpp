@@ -0,0 +1,137 @@
+#include "coro_trace.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <coroutine>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::size_t count_occurrences(const std::string& text, const std::string& pattern)
+    {
+        std::size_t count = 0;
+        for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + pattern.size()))
+            ++count;
+        return count;
+    }
+} // namespace
+
+TEST_CASE("coroutine tracer")
+{
+    using coro::trace::Event;
+
+    auto& tracer = coro::trace::Tracer::instance();
+    tracer.clear();
+
+    int frame = 0;
+
+    SECTION("records events in per-thread buffers")
+    {
+        coro::trace::record(Event::create, &frame);
+
+        std::vector<std::jthread> threads;
+        for (int i = 0; i < 4; ++i)
+            threads.emplace_back([&frame] {
+                for (int j = 0; j < 100; ++j)
+                {
+                    coro::trace::record(Event::resume, &frame);
+                    coro::trace::record(Event::suspend, &frame);
+                }
+            });
+        threads.clear();
+
+        coro::trace::record(Event::destroy, &frame);
+
+        CHECK(tracer.event_count() == 802);
+        CHECK(tracer.dropped() == 0);
+    }
+
+    SECTION("keeps a bounded number of buffers of exited threads")
+    {
+        coro::trace::record(Event::create, &frame);
+        const auto live_buffers = tracer.buffer_count();
+
+        for (std::size_t i = 0; i < coro::trace::Tracer::max_exited_buffers + 10; ++i)
+            std::jthread{[&frame] { coro::trace::record(Event::resume, &frame); }}.join();
+
+        CHECK(tracer.buffer_count() <= live_buffers + coro::trace::Tracer::max_exited_buffers);
+        CHECK(tracer.event_count() >= coro::trace::Tracer::max_exited_buffers + 1); // the most recent threads are exported
+
+        tracer.clear();
+        CHECK(tracer.buffer_count() == live_buffers);
+    }
+
+    SECTION("keeps the most recent events when a buffer wraps")
+    {
+        for (std::size_t i = 0; i < coro::trace::ThreadBuffer::capacity + 10; ++i)
+            coro::trace::record(Event::resume, &frame);
+
+        CHECK(tracer.event_count() == coro::trace::ThreadBuffer::capacity);
+    }
+
+    SECTION("exports Chrome trace JSON")
+    {
+        coro::trace::record(Event::create, &frame);
+        coro::trace::record(Event::resume, &frame);
+        coro::trace::record(Event::suspend, &frame);
+        coro::trace::record(Event::destroy, &frame);
+
+        std::ostringstream out;
+        tracer.write_chrome_trace(out);
+        const auto json = out.str();
+
+        CHECK(json.starts_with("{\"traceEvents\":["));
+        CHECK(count_occurrences(json, "\"ph\":\"B\"") == 1);
+        CHECK(count_occurrences(json, "\"ph\":\"E\"") == 1);
+        CHECK(count_occurrences(json, "\"ph\":\"i\"") == 2);
+
+        std::ostringstream address;
+        address << static_cast<const void*>(&frame);
+        CHECK(count_occurrences(json, address.str()) == 4);
+    }
+}
+
+#if defined(CORO_TRACING)
+struct TracedTask
+{
+    struct promise_type
+    {
+        TracedTask get_return_object()
+        {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() noexcept
+        {
+            CORO_TRACE(create, std::coroutine_handle<promise_type>::from_promise(*this).address());
+            return {};
+        }
+
+        std::suspend_never final_suspend() noexcept
+        {
+            CORO_TRACE(destroy, std::coroutine_handle<promise_type>::from_promise(*this).address());
+            return {};
+        }
+
+        void return_void() noexcept
+        { }
+
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+};
+
+TEST_CASE("coroutine tracer - CORO_TRACE hooks in promise")
+{
+    auto& tracer = coro::trace::Tracer::instance();
+    tracer.clear();
+
+    []() -> TracedTask { co_return; }();
+
+    CHECK(tracer.event_count() == 2);
+}
+#endif
@@ -0,0 +1,281 @@
+#ifndef CORO_TRACE_HPP
+#define CORO_TRACE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// CORO_TRACE(event, frame_address) records a coroutine lifecycle event.
+// Unless CORO_TRACING is defined the macro expands to nothing.
+#if defined(CORO_TRACING)
+#define CORO_TRACE(event, frame) ::coro::trace::record(::coro::trace::Event::event, frame)
+#else
+#define CORO_TRACE(event, frame) ((void)0)
+#endif
+
+namespace coro::trace
+{
+    enum class Event : std::uint8_t
+    {
+        create,
+        suspend,
+        resume,
+        destroy
+    };
+
+    struct Record
+    {
+        std::uint64_t ticks;
+        const void* frame;
+        Event event;
+    };
+
+    // TSC on x86, steady clock nanoseconds elsewhere
+    inline std::uint64_t ticks() noexcept
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    // Ring buffer written only by its owner thread - the oldest records are overwritten
+    class ThreadBuffer
+    {
+    public:
+        static constexpr std::size_t capacity = 1 << 16;
+
+        explicit ThreadBuffer(std::uint32_t thread_index)
+            : records_{std::make_unique<Record[]>(capacity)}
+            , thread_index_{thread_index}
+        { }
+
+        void push(const Record& record) noexcept
+        {
+            const auto head = head_.load(std::memory_order_relaxed);
+            records_[head & (capacity - 1)] = record;
+            head_.store(head + 1, std::memory_order_release);
+        }
+
+        std::uint32_t thread_index() const noexcept
+        {
+            return thread_index_;
+        }
+
+        template <typename F>
+        void for_each(F&& func) const
+        {
+            const auto head = head_.load(std::memory_order_acquire);
+            for (auto i = head > capacity ? head - capacity : 0; i < head; ++i)
+                func(records_[i & (capacity - 1)]);
+        }
+
+        void clear() noexcept
+        {
+            head_.store(0, std::memory_order_release);
+        }
+
+    private:
+        std::unique_ptr<Record[]> records_;
+        std::atomic<std::uint64_t> head_{0};
+        std::uint32_t thread_index_;
+    };
+
+    // Collects per-thread buffers. Recording is lock-free - the registry mutex is taken only
+    // when a thread records its first event, when it exits and during export.
+    // A thread that can't get a buffer (allocation failure) drops its events - they are counted by dropped().
+    // Buffers of exited threads are kept for export until clear(); only the most recent
+    // max_exited_buffers of them are retained.
+    // Export and clear should be called when traced threads are quiescent.
+    class Tracer
+    {
+    public:
+        static constexpr std::size_t max_exited_buffers = 16;
+
+    private:
+        struct Entry
+        {
+            std::shared_ptr<ThreadBuffer> buffer;
+            bool exited = false;
+        };
+
+        // thread_local handle - unregisters the buffer of the thread when it exits
+        class ThreadRegistration
+        {
+            Tracer& tracer_;
+            ThreadBuffer* buffer_;
+
+        public:
+            explicit ThreadRegistration(Tracer& tracer) noexcept
+                : tracer_{tracer}
+                , buffer_{tracer.register_thread()}
+            { }
+
+            ThreadRegistration(const ThreadRegistration&) = delete;
+            ThreadRegistration& operator=(const ThreadRegistration&) = delete;
+
+            ~ThreadRegistration()
+            {
+                if (buffer_)
+                    tracer_.unregister_thread(buffer_);
+            }
+
+            ThreadBuffer* buffer() const noexcept
+            {
+                return buffer_;
+            }
+        };
+
+        std::mutex registry_mtx_;
+        std::vector<Entry> buffers_;
+        std::uint32_t next_thread_index_ = 0;
+        std::atomic<std::uint64_t> dropped_{0};
+        const std::uint64_t start_ticks_ = ticks();
+        const std::chrono::steady_clock::time_point start_time_ = std::chrono::steady_clock::now();
+
+        Tracer() = default;
+
+        // nullptr if the buffer can't be allocated
+        ThreadBuffer* register_thread() noexcept
+        {
+            try
+            {
+                std::lock_guard lk{registry_mtx_};
+                auto buffer = std::make_shared<ThreadBuffer>(next_thread_index_);
+                buffers_.push_back(Entry{buffer});
+                ++next_thread_index_;
+                return buffer.get();
+            }
+            catch (...)
+            {
+                return nullptr;
+            }
+        }
+
+        void unregister_thread(const ThreadBuffer* buffer)
+        {
+            std::lock_guard lk{registry_mtx_};
+
+            std::size_t exited = 0;
+            for (auto& entry : buffers_)
+            {
+                if (entry.buffer.get() == buffer)
+                    entry.exited = true;
+                exited += entry.exited;
+            }
+
+            // the oldest buffers of exited threads are released first
+            if (exited > max_exited_buffers)
+            {
+                auto oldest = std::ranges::find_if(buffers_, &Entry::exited);
+                buffers_.erase(oldest);
+            }
+        }
+
+    public:
+        Tracer(const Tracer&) = delete;
+        Tracer& operator=(const Tracer&) = delete;
+
+        static Tracer& instance()
+        {
+            static Tracer tracer;
+            return tracer;
+        }
+
+        void record(Event event, const void* frame) noexcept
+        {
+            thread_local ThreadRegistration registration{*this};
+
+            if (auto* buffer = registration.buffer())
+                buffer->push(Record{ticks(), frame, event});
+            else
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::uint64_t dropped() const noexcept
+        {
+            return dropped_.load(std::memory_order_relaxed);
+        }
+
+        std::size_t buffer_count()
+        {
+            std::lock_guard lk{registry_mtx_};
+            return buffers_.size();
+        }
+
+        std::size_t event_count()
+        {
+            std::lock_guard lk{registry_mtx_};
+
+            std::size_t count = 0;
+            for (const auto& entry : buffers_)
+                entry.buffer->for_each([&count](const Record&) { ++count; });
+            return count;
+        }
+
+        // Buffers of exited threads are released
+        void clear()
+        {
+            std::lock_guard lk{registry_mtx_};
+            std::erase_if(buffers_, [](const Entry& entry) { return entry.exited; });
+            for (const auto& entry : buffers_)
+                entry.buffer->clear();
+            dropped_.store(0, std::memory_order_relaxed);
+        }
+
+        // Chrome trace event format (chrome://tracing, Perfetto):
+        // resume/suspend are written as begin/end of a slice, create/destroy as instant events
+        void write_chrome_trace(std::ostream& out)
+        {
+            const double elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_time_).count();
+            const double ticks_per_us = static_cast<double>(ticks() - start_ticks_) / std::max(elapsed_us, 1.0);
+
+            std::lock_guard lk{registry_mtx_};
+
+            out << "{\"traceEvents\":[";
+            bool first = true;
+
+            for (const auto& entry : buffers_)
+            {
+                const auto& buffer = entry.buffer;
+                buffer->for_each([&](const Record& record) {
+                    static constexpr const char* names[] = {"create", "suspend", "resume", "destroy"};
+                    static constexpr const char* phases[] = {"i", "E", "B", "i"};
+                    const auto index = static_cast<std::size_t>(record.event);
+
+                    out << (first ? "\n" : ",\n")
+                        << "{\"name\":\"" << names[index] << "\",\"ph\":\"" << phases[index] << "\""
+                        << ",\"ts\":" << static_cast<double>(record.ticks - start_ticks_) / ticks_per_us
+                        << ",\"pid\":1,\"tid\":" << buffer->thread_index();
+                    if (phases[index][0] == 'i')
+                        out << ",\"s\":\"t\"";
+                    out << ",\"args\":{\"frame\":\"" << record.frame << "\"}}";
+
+                    first = false;
+                });
+            }
+
+            out << "\n]}\n";
+        }
+    };
+
+    inline void record(Event event, const void* frame) noexcept
+    {
+        Tracer::instance().record(event, frame);
+    }
+} // namespace coro::trace
+
+#endif
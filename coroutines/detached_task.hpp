@@ -0,0 +1,41 @@
+#ifndef DETACHED_TASK_HPP
+#define DETACHED_TASK_HPP
+
+#include <coroutine>
+#include <exception>
+
+namespace coro
+{
+    // Fire-and-forget coroutine - starts eagerly and destroys its own frame on completion.
+    // Completion has to be signalled by the coroutine body (latch, counter, channel...).
+    struct detached_task
+    {
+        struct promise_type
+        {
+            detached_task get_return_object() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            { }
+
+            void unhandled_exception() noexcept
+            {
+                std::terminate();
+            }
+        };
+    };
+} // namespace coro
+
+#endif
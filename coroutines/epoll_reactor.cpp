@@ -0,0 +1,235 @@
+#include "epoll_reactor.hpp"
+
+#if defined(__linux__)
+
+#include "detached_task.hpp"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <array>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::uint16_t local_port(const coro::io::Socket& socket)
+    {
+        sockaddr_in address{};
+        socklen_t length = sizeof(address);
+        ::getsockname(socket.fd(), reinterpret_cast<sockaddr*>(&address), &length);
+        return ntohs(address.sin_port);
+    }
+
+    coro::io::Socket listen_loopback(coro::io::Reactor& reactor)
+    {
+        const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(fd, SOMAXCONN) < 0)
+            coro::io::throw_errno("listen");
+
+        return coro::io::Socket{reactor, fd};
+    }
+
+    coro::io::Socket connect_loopback(coro::io::Reactor& reactor, std::uint16_t port)
+    {
+        const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+            coro::io::throw_errno("connect");
+
+        const int no_delay = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+        return coro::io::Socket{reactor, fd};
+    }
+} // namespace
+
+coro::detached_task echo_session(coro::io::Socket socket, int& open_sessions)
+{
+    ++open_sessions;
+
+    std::array<std::byte, 4096> buffer;
+    while (std::size_t count = co_await coro::io::async_read(socket, buffer))
+        co_await coro::io::async_write(socket, std::span{buffer}.first(count));
+
+    --open_sessions;
+}
+
+coro::detached_task echo_server(coro::io::Socket& listener, int connection_count, int& open_sessions)
+{
+    for (int i = 0; i < connection_count; ++i)
+        echo_session(co_await coro::io::async_accept(listener), open_sessions);
+}
+
+// Runs the reactor until stop() is called and all sessions are closed by their clients
+void serve(coro::io::Reactor& reactor, const int& open_sessions)
+{
+    reactor.run();
+
+    while (open_sessions > 0)
+        reactor.run_once(100);
+}
+
+// Sends request_count messages and waits for every echo - latencies are in nanoseconds
+// A failure is recorded in errors - an exception escaping a detached_task terminates the program
+coro::detached_task echo_client(coro::io::Socket socket, std::size_t message_size, int request_count,
+    std::vector<std::int64_t>& latencies, std::vector<std::string>& errors, int& running_clients)
+{
+    std::vector<std::byte> request(message_size, std::byte{'x'});
+    std::vector<std::byte> response(message_size);
+
+    try
+    {
+        for (int i = 0; i < request_count; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            co_await coro::io::async_write(socket, request);
+
+            for (std::size_t received = 0; received < response.size();)
+            {
+                const auto count = co_await coro::io::async_read(socket, std::span{response}.subspan(received));
+                if (count == 0)
+                    throw std::runtime_error("Connection closed");
+                received += count;
+            }
+
+            latencies.push_back((std::chrono::steady_clock::now() - start).count());
+        }
+    }
+    catch (const std::exception& e)
+    {
+        errors.push_back(e.what());
+    }
+
+    socket.close();
+
+    if (--running_clients == 0)
+        socket.reactor().stop();
+}
+
+TEST_CASE("epoll reactor - echo")
+{
+    coro::io::Reactor reactor;
+    auto listener = listen_loopback(reactor);
+
+    constexpr int client_count = 8;
+
+    int open_sessions = 0;
+    echo_server(listener, client_count, open_sessions);
+
+    std::vector<std::int64_t> latencies;
+    std::vector<std::string> errors;
+    int running_clients = client_count;
+
+    SECTION("small messages")
+    {
+        for (int i = 0; i < client_count; ++i)
+            echo_client(connect_loopback(reactor, local_port(listener)), 16, 100, latencies, errors, running_clients);
+
+        serve(reactor, open_sessions);
+
+        CHECK(latencies.size() == client_count * 100);
+    }
+
+    SECTION("messages larger than socket buffers")
+    {
+        for (int i = 0; i < client_count; ++i)
+            echo_client(connect_loopback(reactor, local_port(listener)), 1024 * 1024, 2, latencies, errors, running_clients);
+
+        serve(reactor, open_sessions);
+
+        CHECK(latencies.size() == client_count * 2);
+    }
+
+    CHECK(errors.empty());
+    CHECK(running_clients == 0);
+    CHECK(open_sessions == 0);
+}
+
+TEST_CASE("epoll reactor - errors are reported as exceptions")
+{
+    coro::io::Reactor reactor;
+    auto listener = listen_loopback(reactor);
+    auto client = connect_loopback(reactor, local_port(listener));
+
+    std::array<std::byte, 16> buffer{};
+    bool failed = false;
+
+    [&]() -> coro::detached_task {
+        try
+        {
+            co_await coro::io::async_read(listener, buffer); // listening socket can't be read
+        }
+        catch (const std::system_error&)
+        {
+            failed = true;
+        }
+    }();
+
+    CHECK(failed);
+}
+
+///////////////////////////////////////////////////////////////////////
+// Benchmark
+
+TEST_CASE("epoll reactor benchmark", "[.benchmark]")
+{
+    constexpr int request_count = 2'000;
+    constexpr std::size_t message_size = 64;
+
+    for (int client_count : {1, 64, 256})
+    {
+        coro::io::Reactor server_reactor;
+        auto listener = listen_loopback(server_reactor);
+        int open_sessions = 0;
+        echo_server(listener, client_count, open_sessions);
+        std::jthread server_thread{[&] { serve(server_reactor, open_sessions); }};
+
+        coro::io::Reactor client_reactor;
+        std::vector<std::int64_t> latencies;
+        latencies.reserve(static_cast<std::size_t>(client_count) * request_count);
+        std::vector<std::string> errors;
+        int running_clients = client_count;
+
+        for (int i = 0; i < client_count; ++i)
+            echo_client(connect_loopback(client_reactor, local_port(listener)), message_size, request_count, latencies, errors, running_clients);
+
+        const auto start = std::chrono::steady_clock::now();
+        client_reactor.run();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        server_reactor.stop();
+
+        REQUIRE(errors.empty());
+
+        std::ranges::sort(latencies);
+        const auto percentile = [&](double p) {
+            return latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))] / 1000.0;
+        };
+
+        std::cout << std::left << std::setw(40) << ("echo - " + std::to_string(client_count) + " connections") << std::right
+                  << std::fixed << std::setprecision(0) << std::setw(12) << static_cast<double>(latencies.size()) / elapsed.count() << " req/s"
+                  << std::setprecision(1) << std::setw(10) << percentile(0.5) << " us p50"
+                  << std::setw(10) << percentile(0.99) << " us p99\n";
+    }
+}
+
+#endif
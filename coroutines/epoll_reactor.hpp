@@ -0,0 +1,402 @@
+#ifndef EPOLL_REACTOR_HPP
+#define EPOLL_REACTOR_HPP
+
+#if defined(__linux__)
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <memory>
+#include <span>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <system_error>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace coro::io
+{
+    [[noreturn]] inline void throw_errno(const char* what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    namespace detail
+    {
+        // Pending I/O operation - performed by the reactor when the descriptor becomes ready
+        struct Operation
+        {
+            std::coroutine_handle<> coro;
+            bool (*perform)(Operation& op) noexcept; // false - operation would block
+        };
+
+        struct DescriptorState
+        {
+            int fd;
+            Operation* reader = nullptr;
+            Operation* writer = nullptr;
+        };
+    } // namespace detail
+
+    class Socket;
+
+    // Edge-triggered epoll reactor. Descriptors are registered once (EPOLLIN | EPOLLOUT | EPOLLET);
+    // an operation is attempted immediately and parked only when it would block.
+    // Readiness events are collected in batches and the completed operations are performed
+    // before any coroutine is resumed.
+    // Sockets and coroutines of a reactor are used on the thread running the reactor;
+    // only stop() may be called from other threads.
+    class Reactor
+    {
+    public:
+        static constexpr int max_events = 256;
+
+        Reactor()
+            : epoll_fd_{::epoll_create1(EPOLL_CLOEXEC)}
+            , wake_fd_{::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)}
+        {
+            if (epoll_fd_ < 0 || wake_fd_ < 0)
+                throw_errno("Reactor");
+
+            epoll_event event{.events = EPOLLIN, .data = {.ptr = nullptr}};
+            if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event) < 0)
+                throw_errno("epoll_ctl");
+        }
+
+        Reactor(const Reactor&) = delete;
+        Reactor& operator=(const Reactor&) = delete;
+
+        ~Reactor()
+        {
+            ::close(wake_fd_);
+            ::close(epoll_fd_);
+        }
+
+        // Processes readiness events until stop() is called
+        void run()
+        {
+            while (!stop_requested_.load(std::memory_order_acquire))
+                run_once(-1);
+
+            stop_requested_.store(false, std::memory_order_relaxed);
+        }
+
+        // Waits for a batch of events and resumes coroutines whose operations completed
+        void run_once(int timeout_ms)
+        {
+            std::array<epoll_event, max_events> events;
+            const int count = ::epoll_wait(epoll_fd_, events.data(), max_events, timeout_ms);
+
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                    return;
+                throw_errno("epoll_wait");
+            }
+
+            ready_.clear();
+
+            for (const auto& event : std::span{events}.first(count))
+            {
+                auto* state = static_cast<detail::DescriptorState*>(event.data.ptr);
+
+                if (!state)
+                {
+                    std::uint64_t value;
+                    [[maybe_unused]] auto result = ::read(wake_fd_, &value, sizeof(value));
+                    continue;
+                }
+
+                constexpr std::uint32_t failure = EPOLLERR | EPOLLHUP;
+
+                if ((event.events & (EPOLLIN | EPOLLRDHUP | failure)) && state->reader)
+                    complete(state->reader);
+
+                if ((event.events & (EPOLLOUT | failure)) && state->writer)
+                    complete(state->writer);
+            }
+
+            for (auto coro : ready_)
+                coro.resume();
+        }
+
+        void stop()
+        {
+            stop_requested_.store(true, std::memory_order_release);
+
+            const std::uint64_t value = 1;
+            [[maybe_unused]] auto result = ::write(wake_fd_, &value, sizeof(value));
+        }
+
+    private:
+        friend class Socket;
+
+        int epoll_fd_;
+        int wake_fd_;
+        std::atomic<bool> stop_requested_{false};
+        std::vector<std::coroutine_handle<>> ready_;
+
+        void complete(detail::Operation*& op)
+        {
+            if (op->perform(*op))
+                ready_.push_back(std::exchange(op, nullptr)->coro);
+        }
+
+        void add(detail::DescriptorState& state)
+        {
+            epoll_event event{.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET, .data = {.ptr = &state}};
+            if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state.fd, &event) < 0)
+                throw_errno("epoll_ctl");
+        }
+
+        void remove(detail::DescriptorState& state) noexcept
+        {
+            ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, state.fd, nullptr);
+        }
+    };
+
+    // Non-blocking socket registered in a reactor - owns the descriptor
+    class Socket
+    {
+    public:
+        Socket(Reactor& reactor, int fd)
+            : reactor_{&reactor}
+            , state_{std::make_unique<detail::DescriptorState>(fd)}
+        {
+            if (::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK) < 0)
+            {
+                ::close(fd);
+                throw_errno("fcntl");
+            }
+
+            try
+            {
+                reactor_->add(*state_);
+            }
+            catch (...)
+            {
+                ::close(fd); // the destructor doesn't run for a socket that failed to construct
+                throw;
+            }
+        }
+
+        Socket(Socket&&) noexcept = default;
+
+        Socket& operator=(Socket&& other) noexcept
+        {
+            if (this != &other)
+            {
+                close();
+                reactor_ = other.reactor_;
+                state_ = std::move(other.state_);
+            }
+            return *this;
+        }
+
+        ~Socket()
+        {
+            close();
+        }
+
+        int fd() const noexcept
+        {
+            return state_ ? state_->fd : -1;
+        }
+
+        Reactor& reactor() const noexcept
+        {
+            return *reactor_;
+        }
+
+        detail::DescriptorState& state() const noexcept
+        {
+            return *state_;
+        }
+
+        void close() noexcept
+        {
+            if (state_)
+            {
+                reactor_->remove(*state_);
+                ::close(state_->fd);
+                state_.reset();
+            }
+        }
+
+    private:
+        Reactor* reactor_;
+        std::unique_ptr<detail::DescriptorState> state_;
+    };
+
+    namespace detail
+    {
+        // Awaiter of a single operation on a socket:
+        //  - Derived::try_perform() - attempts the syscall, returns false if it would block
+        //  - Derived::await_resume() - returns the result (or throws)
+        template <typename Derived>
+        struct SocketAwaiter : Operation
+        {
+            Socket& socket;
+            int error = 0;
+
+            explicit SocketAwaiter(Socket& socket)
+                : Operation{{}, &SocketAwaiter::perform_operation}
+                , socket{socket}
+            { }
+
+            bool await_ready() noexcept
+            {
+                return static_cast<Derived&>(*this).try_perform();
+            }
+
+            void await_suspend(std::coroutine_handle<> coro) noexcept
+            {
+                this->coro = coro;
+                Derived::slot(socket.state()) = this;
+            }
+
+        protected:
+            // false if the operation would block; otherwise stores the error (0 - success)
+            bool check(long result) noexcept
+            {
+                if (result >= 0)
+                    return true;
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    return false;
+                if (errno == EINTR)
+                    return static_cast<Derived&>(*this).try_perform();
+
+                error = errno;
+                return true;
+            }
+
+            void rethrow_error(const char* what) const
+            {
+                if (error)
+                    throw std::system_error(error, std::generic_category(), what);
+            }
+
+        private:
+            static bool perform_operation(Operation& op) noexcept
+            {
+                return static_cast<Derived&>(op).try_perform();
+            }
+        };
+
+        struct ReadAwaiter : SocketAwaiter<ReadAwaiter>
+        {
+            std::span<std::byte> buffer;
+            std::size_t bytes_read = 0;
+
+            ReadAwaiter(Socket& socket, std::span<std::byte> buffer)
+                : SocketAwaiter{socket}
+                , buffer{buffer}
+            { }
+
+            static Operation*& slot(DescriptorState& state) noexcept
+            {
+                return state.reader;
+            }
+
+            bool try_perform() noexcept
+            {
+                const auto result = ::read(socket.fd(), buffer.data(), buffer.size());
+                if (result > 0)
+                    bytes_read = static_cast<std::size_t>(result);
+                return check(result);
+            }
+
+            std::size_t await_resume() const
+            {
+                rethrow_error("async_read");
+                return bytes_read;
+            }
+        };
+
+        struct WriteAwaiter : SocketAwaiter<WriteAwaiter>
+        {
+            std::span<const std::byte> buffer;
+            std::size_t bytes_written = 0;
+
+            WriteAwaiter(Socket& socket, std::span<const std::byte> buffer)
+                : SocketAwaiter{socket}
+                , buffer{buffer}
+            { }
+
+            static Operation*& slot(DescriptorState& state) noexcept
+            {
+                return state.writer;
+            }
+
+            bool try_perform() noexcept
+            {
+                while (bytes_written < buffer.size())
+                {
+                    const auto result = ::send(socket.fd(), buffer.data() + bytes_written, buffer.size() - bytes_written, MSG_NOSIGNAL);
+                    if (result < 0)
+                        return check(result);
+                    bytes_written += static_cast<std::size_t>(result);
+                }
+                return true;
+            }
+
+            std::size_t await_resume() const
+            {
+                rethrow_error("async_write");
+                return bytes_written;
+            }
+        };
+
+        struct AcceptAwaiter : SocketAwaiter<AcceptAwaiter>
+        {
+            int accepted_fd = -1;
+
+            using SocketAwaiter::SocketAwaiter;
+
+            static Operation*& slot(DescriptorState& state) noexcept
+            {
+                return state.reader;
+            }
+
+            bool try_perform() noexcept
+            {
+                accepted_fd = ::accept4(socket.fd(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                return check(accepted_fd);
+            }
+
+            Socket await_resume() const
+            {
+                rethrow_error("async_accept");
+                return Socket{socket.reactor(), accepted_fd};
+            }
+        };
+    } // namespace detail
+
+    // co_await async_read(socket, buffer) - number of bytes read (0 - end of stream)
+    inline detail::ReadAwaiter async_read(Socket& socket, std::span<std::byte> buffer)
+    {
+        return detail::ReadAwaiter{socket, buffer};
+    }
+
+    // co_await async_write(socket, data) - completes when all data has been written
+    inline detail::WriteAwaiter async_write(Socket& socket, std::span<const std::byte> data)
+    {
+        return detail::WriteAwaiter{socket, data};
+    }
+
+    // co_await async_accept(listener) - accepted connection registered in the listener's reactor
+    inline detail::AcceptAwaiter async_accept(Socket& listener)
+    {
+        return detail::AcceptAwaiter{listener};
+    }
+} // namespace coro::io
+
+#endif
+
+#endif
@@ -0,0 +1,229 @@
+#include "fiber.hpp"
+
+#if defined(__linux__)
+
+#include "channel.hpp"
+#include "task_resumer.hpp"
+#include "work_stealing_scheduler.hpp"
+
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <ucontext.h>
+#include <vector>
+
+TEST_CASE("fiber - yields to the caller of resume()")
+{
+    std::vector<std::string> log;
+
+    coro::Fiber fiber{[&] {
+        log.push_back("step 1");
+        coro::this_fiber::yield();
+        log.push_back("step 2");
+        coro::this_fiber::yield();
+        log.push_back("end");
+    }};
+
+    CHECK(log.empty()); // lazy start
+
+    while (fiber.resume())
+        log.push_back("caller");
+
+    CHECK(log == std::vector<std::string>{"step 1", "caller", "step 2", "caller", "end"});
+    CHECK(fiber.done());
+    CHECK_FALSE(fiber.resume());
+}
+
+// legacy code - suspends deep inside ordinary function calls
+void visit(int depth, std::vector<int>& path)
+{
+    if (depth == 0)
+    {
+        coro::this_fiber::yield();
+        return;
+    }
+
+    path.push_back(depth);
+    visit(depth - 1, path);
+}
+
+TEST_CASE("fiber - suspends from nested function calls")
+{
+    std::vector<int> path;
+    coro::Fiber fiber{[&] { visit(1'000, path); }};
+
+    CHECK(fiber.resume());
+    CHECK(path.size() == 1'000);
+    CHECK_FALSE(fiber.resume());
+}
+
+TEST_CASE("fiber - exceptions and destruction")
+{
+    SECTION("exception escaping the fiber is rethrown by resume()")
+    {
+        coro::Fiber fiber{[] {
+            coro::this_fiber::yield();
+            throw std::runtime_error{"fiber error"};
+        }};
+
+        CHECK(fiber.resume());
+        CHECK_THROWS_AS(fiber.resume(), std::runtime_error);
+        CHECK(fiber.done());
+    }
+
+    SECTION("destroying a suspended fiber unwinds its stack")
+    {
+        auto resource = std::make_shared<int>(42);
+
+        {
+            coro::Fiber fiber{[resource] {
+                auto local_copy = resource;
+                while (true)
+                    coro::this_fiber::yield();
+            }};
+
+            fiber.resume();
+            CHECK(resource.use_count() == 3);
+        }
+
+        CHECK(resource.use_count() == 1);
+    }
+}
+
+// pthread_self() is a const function - its result could be reused across a switch to another thread
+[[gnu::noipa]] std::thread::id current_thread_id()
+{
+    return std::this_thread::get_id();
+}
+
+TEST_CASE("fiber - awaits stackless awaiters")
+{
+    SECTION("hops to a thread pool")
+    {
+        coro::WorkStealingScheduler pool{2};
+        std::thread::id before;
+        std::thread::id after;
+
+        coro::Fiber fiber{[&] {
+            before = current_thread_id();
+            coro::this_fiber::await(pool.schedule()); // resumed by a worker thread
+            after = current_thread_id();
+        }};
+
+        CHECK(fiber.resume()); // suspended in await
+        fiber.join();
+
+        CHECK(before == std::this_thread::get_id());
+        CHECK(after != before);
+    }
+
+    SECTION("channel between a fiber and a coroutine-free caller")
+    {
+        coro::channel<int> ch{1};
+        std::vector<int> received;
+
+        coro::Fiber consumer{[&] {
+            while (auto value = coro::this_fiber::await(ch.receive()))
+                received.push_back(*value);
+        }};
+
+        CHECK(consumer.resume()); // waits for a value
+
+        for (int i = 1; i <= 3; ++i)
+            ch.try_send(i); // resumes the fiber inline
+        ch.close();
+
+        CHECK(received == std::vector{1, 2, 3});
+        CHECK(consumer.done());
+    }
+}
+
+TEST_CASE("fiber - stacks are pooled")
+{
+    coro::StackPool pool{64 * 1024};
+
+    const void* first_stack = nullptr;
+    {
+        coro::Fiber fiber{[&] {
+            int local = 0;
+            first_stack = &local;
+        }, pool};
+        fiber.resume();
+    }
+
+    const void* second_stack = nullptr;
+    coro::Fiber fiber{[&] {
+        int local = 0;
+        second_stack = &local;
+    }, pool};
+    fiber.resume();
+
+    CHECK(first_stack == second_stack);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark
+
+TaskResumer stackless_loop()
+{
+    while (true)
+        co_await std::suspend_always{};
+}
+
+namespace
+{
+    ucontext_t main_context;
+    ucontext_t loop_context;
+
+    void ucontext_loop()
+    {
+        while (true)
+            ::swapcontext(&loop_context, &main_context);
+    }
+} // namespace
+
+TEST_CASE("fiber benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+
+    constexpr int count = 1'000'000;
+
+    auto task = stackless_loop();
+    bm::run("TaskResumer::resume() + co_await suspend", count, [&] {
+        for (int i = 0; i < count; ++i)
+            task.resume();
+    });
+
+    coro::Fiber fiber{[] {
+        while (true)
+            coro::this_fiber::yield();
+    }};
+    bm::run("Fiber::resume() + yield()", count, [&] {
+        for (int i = 0; i < count; ++i)
+            fiber.resume();
+    });
+
+    auto stack = coro::StackPool::default_pool().acquire();
+    ::getcontext(&loop_context);
+    loop_context.uc_stack.ss_sp = stack.bottom;
+    loop_context.uc_stack.ss_size = stack.size;
+    ::makecontext(&loop_context, ucontext_loop, 0);
+    bm::run("swapcontext() round trip", count, [&] {
+        for (int i = 0; i < count; ++i)
+            ::swapcontext(&main_context, &loop_context);
+    });
+    coro::StackPool::default_pool().release(stack);
+
+    bm::run("Fiber - create + run + destroy (pooled stack)", count, [&] {
+        for (int i = 0; i < count; ++i)
+        {
+            coro::Fiber fiber{[] {}};
+            fiber.resume();
+        }
+    });
+}
+
+#endif
@@ -0,0 +1,557 @@
+#ifndef FIBER_HPP
+#define FIBER_HPP
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <mutex>
+#include <sys/mman.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#if !defined(__x86_64__)
+#include <ucontext.h>
+#endif
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+#if defined(__SANITIZE_THREAD__)
+#include <sanitizer/tsan_interface.h>
+#endif
+
+namespace coro
+{
+    // Stacks for fibers - mmap-ed with a PROT_NONE guard page below the stack, so a stack overflow
+    // crashes instead of corrupting memory. Released stacks are kept for reuse.
+    class StackPool
+    {
+    public:
+        struct Stack
+        {
+            std::byte* bottom = nullptr; // lowest usable address (guard page is below)
+            std::size_t size = 0;
+        };
+
+        explicit StackPool(std::size_t stack_size = 256 * 1024)
+            : page_size_{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))}
+            , stack_size_{(stack_size + page_size_ - 1) / page_size_ * page_size_}
+        { }
+
+        StackPool(const StackPool&) = delete;
+        StackPool& operator=(const StackPool&) = delete;
+
+        // All stacks have to be released before the pool is destroyed
+        ~StackPool()
+        {
+            for (auto stack : free_stacks_)
+                ::munmap(stack.bottom - page_size_, stack.size + page_size_);
+        }
+
+        static StackPool& default_pool()
+        {
+            static StackPool pool;
+            return pool;
+        }
+
+        std::size_t stack_size() const noexcept
+        {
+            return stack_size_;
+        }
+
+        Stack acquire()
+        {
+            {
+                std::lock_guard lk{mtx_};
+                if (!free_stacks_.empty())
+                {
+                    auto stack = free_stacks_.back();
+                    free_stacks_.pop_back();
+                    return stack;
+                }
+            }
+
+            void* memory = ::mmap(nullptr, stack_size_ + page_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+            if (memory == MAP_FAILED)
+                throw std::system_error(errno, std::generic_category(), "mmap");
+
+            if (::mprotect(memory, page_size_, PROT_NONE) < 0)
+            {
+                const int error = errno;
+                ::munmap(memory, stack_size_ + page_size_);
+                throw std::system_error(error, std::generic_category(), "mprotect");
+            }
+
+            return Stack{static_cast<std::byte*>(memory) + page_size_, stack_size_};
+        }
+
+        void release(Stack stack)
+        {
+#if defined(__SANITIZE_ADDRESS__)
+            // a finished fiber leaves redzones of its frames poisoned - the next fiber starts with a clean stack
+            ASAN_UNPOISON_MEMORY_REGION(stack.bottom, stack.size);
+#endif
+            std::lock_guard lk{mtx_};
+            free_stacks_.push_back(stack);
+        }
+
+    private:
+        const std::size_t page_size_;
+        const std::size_t stack_size_;
+        std::mutex mtx_;
+        std::vector<Stack> free_stacks_;
+    };
+
+    class Fiber;
+
+    namespace detail
+    {
+#if defined(__x86_64__)
+        // Saves callee-saved registers, MXCSR and x87 control word on the current stack,
+        // stores the stack pointer to *save_sp and restores the context saved at load_sp.
+        // Weak symbols - the header can be included in many translation units.
+        asm(R"(
+            .pushsection .text
+            .weak coro_fiber_switch
+            .type coro_fiber_switch, @function
+            .p2align 4
+        coro_fiber_switch:
+            pushq %rbp
+            pushq %rbx
+            pushq %r12
+            pushq %r13
+            pushq %r14
+            pushq %r15
+            subq $8, %rsp
+            stmxcsr (%rsp)
+            fnstcw 4(%rsp)
+            movq %rsp, (%rdi)
+            movq %rsi, %rsp
+            ldmxcsr (%rsp)
+            fldcw 4(%rsp)
+            addq $8, %rsp
+            popq %r15
+            popq %r14
+            popq %r13
+            popq %r12
+            popq %rbx
+            popq %rbp
+            ret
+            .size coro_fiber_switch, .-coro_fiber_switch
+
+            .weak coro_fiber_start
+            .type coro_fiber_start, @function
+            .p2align 4
+        coro_fiber_start:
+            movq %r12, %rdi
+            callq *%r13
+            ud2
+            .size coro_fiber_start, .-coro_fiber_start
+            .popsection
+        )");
+
+        extern "C" void coro_fiber_switch(void** save_sp, void* load_sp);
+        extern "C" void coro_fiber_start();
+
+        struct Context
+        {
+            void* sp = nullptr;
+        };
+
+        inline void switch_context(Context& from, Context& to) noexcept
+        {
+            coro_fiber_switch(&from.sp, to.sp);
+        }
+
+        // Prepares a stack frame popped by coro_fiber_switch - returns to coro_fiber_start,
+        // which calls entry(arg) with an aligned stack
+        inline void make_context(Context& context, StackPool::Stack stack, void (*entry)(Fiber*), Fiber* arg) noexcept
+        {
+            auto top = reinterpret_cast<std::uintptr_t>(stack.bottom + stack.size) & ~std::uintptr_t{15};
+            auto* frame = reinterpret_cast<std::uint64_t*>(top - 80);
+
+            const std::uint32_t mxcsr = 0x1F80;
+            const std::uint16_t fpu_control_word = 0x037F;
+            std::memcpy(frame, &mxcsr, sizeof(mxcsr));
+            std::memcpy(reinterpret_cast<std::byte*>(frame) + 4, &fpu_control_word, sizeof(fpu_control_word));
+
+            frame[1] = 0;                                            // r15
+            frame[2] = 0;                                            // r14
+            frame[3] = reinterpret_cast<std::uint64_t>(entry);       // r13
+            frame[4] = reinterpret_cast<std::uint64_t>(arg);         // r12
+            frame[5] = 0;                                            // rbx
+            frame[6] = 0;                                            // rbp
+            frame[7] = reinterpret_cast<std::uint64_t>(&coro_fiber_start);
+
+            context.sp = frame;
+        }
+#else
+        // Portable fallback - swapcontext also saves/restores the signal mask (a system call per switch)
+        struct Context
+        {
+            ucontext_t uc;
+        };
+
+        inline void switch_context(Context& from, Context& to) noexcept
+        {
+            ::swapcontext(&from.uc, &to.uc);
+        }
+
+        // makecontext passes only int arguments - pointers are split into halves
+        inline void start_fiber(unsigned entry_high, unsigned entry_low, unsigned arg_high, unsigned arg_low)
+        {
+            auto join = [](unsigned high, unsigned low) { return static_cast<std::uintptr_t>((std::uint64_t{high} << 32) | low); };
+            auto* entry = reinterpret_cast<void (*)(Fiber*)>(join(entry_high, entry_low));
+            entry(reinterpret_cast<Fiber*>(join(arg_high, arg_low)));
+        }
+
+        inline void make_context(Context& context, StackPool::Stack stack, void (*entry)(Fiber*), Fiber* arg) noexcept
+        {
+            ::getcontext(&context.uc);
+            context.uc.uc_stack.ss_sp = stack.bottom;
+            context.uc.uc_stack.ss_size = stack.size;
+            context.uc.uc_link = nullptr;
+
+            const std::uint64_t entry_address = reinterpret_cast<std::uintptr_t>(entry);
+            const std::uint64_t arg_address = reinterpret_cast<std::uintptr_t>(arg);
+            ::makecontext(&context.uc, reinterpret_cast<void (*)()>(&start_fiber), 4,
+                static_cast<unsigned>(entry_address >> 32), static_cast<unsigned>(entry_address),
+                static_cast<unsigned>(arg_address >> 32), static_cast<unsigned>(arg_address));
+        }
+#endif
+
+        // The fiber running on this thread - opaque to the optimizer, a fiber can continue on another thread
+        // after a switch and the address of a thread_local must not be cached across it
+        [[gnu::noipa]] inline Fiber*& current_fiber() noexcept
+        {
+            thread_local Fiber* current = nullptr;
+            return current;
+        }
+
+        // thrown by yield() in a fiber destroyed before it finished
+        struct FiberUnwind
+        { };
+
+        // Coroutine resuming a fiber suspended in this_fiber::await() - its handle is given to awaiters
+        struct FiberResumer
+        {
+            struct promise_type
+            {
+                FiberResumer get_return_object() noexcept
+                {
+                    return FiberResumer{std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::suspend_always initial_suspend() noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_always final_suspend() noexcept
+                {
+                    return {};
+                }
+
+                void return_void() noexcept
+                { }
+
+                void unhandled_exception() noexcept
+                {
+                    std::terminate();
+                }
+            };
+
+            std::coroutine_handle<promise_type> coro;
+        };
+    } // namespace detail
+
+    namespace this_fiber
+    {
+        void yield();
+
+        template <typename Awaiter>
+        decltype(auto) await(Awaiter&& awaiter);
+    } // namespace this_fiber
+
+    // Stackful coroutine - runs a function on its own stack, so it can suspend from any depth of
+    // ordinary (not co_await-aware) function calls:
+    //  - this_fiber::yield() returns control to the caller of resume() (like co_await std::suspend_always)
+    //  - this_fiber::await(awaiter) suspends on any awaiter of the stackless world (co_await pool.schedule(),
+    //    channel.receive(), mutex.lock()...) - the fiber is resumed by the awaited operation
+    // On x86-64 the context switch is a few instructions (callee-saved registers + stack pointer),
+    // other platforms use swapcontext.
+    class Fiber
+    {
+    public:
+        template <typename F>
+            requires std::is_invocable_v<F&>
+        explicit Fiber(F&& fn, StackPool& stack_pool = StackPool::default_pool())
+            : fn_{std::forward<F>(fn)}
+            , stack_pool_{stack_pool}
+            , stack_{stack_pool.acquire()}
+        {
+            detail::make_context(context_, stack_, &fiber_entry, this);
+#if defined(__SANITIZE_THREAD__)
+            tsan_fiber_ = __tsan_create_fiber(0);
+#endif
+        }
+
+        Fiber(const Fiber&) = delete;
+        Fiber& operator=(const Fiber&) = delete;
+
+        // A started fiber is unwound (yield() throws an exception caught at the bottom of the fiber).
+        // The fiber must not be destroyed while it is suspended in await() or running on another thread.
+        ~Fiber()
+        {
+            if (started_ && !done_)
+            {
+                unwinding_ = true;
+                run().next.resume();
+            }
+
+            if (resumer_.coro)
+                resumer_.coro.destroy();
+#if defined(__SANITIZE_THREAD__)
+            __tsan_destroy_fiber(tsan_fiber_);
+#endif
+            stack_pool_.release(stack_);
+        }
+
+        // Runs the fiber until it yields or finishes - false when finished.
+        // Exceptions escaping the fiber function are rethrown.
+        bool resume()
+        {
+            if (done_)
+                return false;
+
+            const auto [next, finished] = run();
+            next.resume(); // the fiber may continue on another thread now - its state can't be read
+
+            if (finished)
+                rethrow_if_failed();
+            return !finished;
+        }
+
+        // Only for the thread resuming the fiber - use join() for fibers continuing on other threads
+        bool done() const noexcept
+        {
+            return done_;
+        }
+
+        // Blocks until the fiber finishes - exceptions escaping the fiber function are rethrown
+        void join()
+        {
+            finished_.wait();
+            rethrow_if_failed();
+        }
+
+    private:
+        friend void this_fiber::yield();
+
+        template <typename Awaiter>
+        friend decltype(auto) this_fiber::await(Awaiter&& awaiter);
+
+        std::move_only_function<void()> fn_;
+        StackPool& stack_pool_;
+        StackPool::Stack stack_;
+        detail::Context context_;
+        detail::Context caller_context_;
+        bool started_ = false;
+        bool done_ = false;
+        bool unwinding_ = false;
+        std::latch finished_{1};
+        std::exception_ptr exception_;
+        detail::FiberResumer resumer_;
+
+        // await_suspend of the awaiter the fiber is suspended on - called after the fiber's context is saved
+        std::coroutine_handle<> (*suspend_action_)(void* awaiter, std::coroutine_handle<> resumer) = nullptr;
+        void* suspended_awaiter_ = nullptr;
+
+#if defined(__SANITIZE_ADDRESS__)
+        void* asan_fake_stack_ = nullptr;
+        const void* asan_caller_bottom_ = nullptr;
+        std::size_t asan_caller_size_ = 0;
+#endif
+#if defined(__SANITIZE_THREAD__)
+        void* tsan_fiber_ = nullptr;
+        void* tsan_caller_ = nullptr;
+#endif
+
+        [[noreturn]] static void fiber_entry(Fiber* self)
+        {
+            self->finish_switch_in();
+
+            try
+            {
+                self->fn_();
+            }
+            catch (const detail::FiberUnwind&)
+            { }
+            catch (...)
+            {
+                self->exception_ = std::current_exception();
+            }
+
+            self->done_ = true;
+            self->switch_out();
+            std::terminate(); // a finished fiber is never resumed
+        }
+
+        struct SwitchResult
+        {
+            std::coroutine_handle<> next; // noop_coroutine or the resumer, when an awaited operation completed synchronously
+            bool finished;
+        };
+
+        // Switches into the fiber until it yields, finishes or suspends in await()
+        SwitchResult run()
+        {
+            started_ = true;
+
+            auto& current = detail::current_fiber();
+            auto* previous = std::exchange(current, this);
+
+#if defined(__SANITIZE_ADDRESS__)
+            void* fake_stack = nullptr;
+            __sanitizer_start_switch_fiber(&fake_stack, stack_.bottom, stack_.size);
+#endif
+#if defined(__SANITIZE_THREAD__)
+            tsan_caller_ = __tsan_get_current_fiber();
+            __tsan_switch_to_fiber(tsan_fiber_, 0);
+#endif
+            detail::switch_context(caller_context_, context_);
+#if defined(__SANITIZE_ADDRESS__)
+            __sanitizer_finish_switch_fiber(fake_stack, nullptr, nullptr);
+#endif
+
+            detail::current_fiber() = previous;
+
+            if (auto action = std::exchange(suspend_action_, nullptr))
+                return {action(suspended_awaiter_, resumer_.coro), false};
+
+            if (!done_)
+                return {std::noop_coroutine(), false};
+
+            finished_.count_down(); // the fiber may be destroyed by a joining thread from now on
+            return {std::noop_coroutine(), true};
+        }
+
+        void rethrow_if_failed()
+        {
+            if (exception_)
+                std::rethrow_exception(std::exchange(exception_, nullptr));
+        }
+
+        void finish_switch_in() noexcept
+        {
+#if defined(__SANITIZE_ADDRESS__)
+            __sanitizer_finish_switch_fiber(asan_fake_stack_, &asan_caller_bottom_, &asan_caller_size_);
+#endif
+        }
+
+        void switch_out()
+        {
+#if defined(__SANITIZE_ADDRESS__)
+            __sanitizer_start_switch_fiber(done_ ? nullptr : &asan_fake_stack_, asan_caller_bottom_, asan_caller_size_);
+#endif
+#if defined(__SANITIZE_THREAD__)
+            __tsan_switch_to_fiber(tsan_caller_, 0);
+#endif
+            detail::switch_context(context_, caller_context_);
+            finish_switch_in();
+        }
+
+        detail::FiberResumer make_resumer()
+        {
+            struct SwitchIn
+            {
+                Fiber& fiber;
+
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<>) const
+                {
+                    return fiber.run().next;
+                }
+
+                void await_resume() const noexcept
+                { }
+            };
+
+            while (true)
+                co_await SwitchIn{*this};
+        }
+    };
+
+    namespace this_fiber
+    {
+        inline bool inside_fiber() noexcept
+        {
+            return detail::current_fiber() != nullptr;
+        }
+
+        // Returns control to the caller of Fiber::resume()
+        inline void yield()
+        {
+            Fiber* fiber = detail::current_fiber();
+            fiber->switch_out();
+
+            if (fiber->unwinding_)
+                throw detail::FiberUnwind{};
+        }
+
+        // Suspends the fiber on an awaiter (an object with await_ready/await_suspend/await_resume);
+        // returns the result of await_resume()
+        template <typename Awaiter>
+        decltype(auto) await(Awaiter&& awaiter)
+        {
+            if (!awaiter.await_ready())
+            {
+                Fiber* fiber = detail::current_fiber();
+
+                if (!fiber->resumer_.coro)
+                    fiber->resumer_ = fiber->make_resumer();
+
+                using AwaiterType = std::remove_reference_t<Awaiter>;
+                fiber->suspended_awaiter_ = std::addressof(awaiter);
+                fiber->suspend_action_ = [](void* suspended, std::coroutine_handle<> resumer) -> std::coroutine_handle<> {
+                    auto& awaiter = *static_cast<AwaiterType*>(suspended);
+                    using Result = decltype(awaiter.await_suspend(resumer));
+
+                    if constexpr (std::is_void_v<Result>)
+                    {
+                        awaiter.await_suspend(resumer);
+                        return std::noop_coroutine();
+                    }
+                    else if constexpr (std::is_same_v<Result, bool>)
+                        return awaiter.await_suspend(resumer) ? std::noop_coroutine() : resumer;
+                    else
+                        return awaiter.await_suspend(resumer);
+                };
+
+                fiber->switch_out();
+            }
+
+            return awaiter.await_resume();
+        }
+    } // namespace this_fiber
+} // namespace coro
+
+#endif
+
+#endif
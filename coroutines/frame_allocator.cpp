@@ -0,0 +1,205 @@
+#include "frame_allocator.hpp"
+#include "generator.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <coroutine>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <thread>
+#include <vector>
+
+class PooledTask
+{
+public:
+    struct promise_type : coro::PooledFramePromise
+    {
+        PooledTask get_return_object()
+        {
+            return PooledTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept
+        {
+            return {};
+        }
+
+        std::suspend_always final_suspend() noexcept
+        {
+            return {};
+        }
+
+        void return_void() noexcept
+        { }
+
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+
+    explicit PooledTask(std::coroutine_handle<promise_type> coro_hndl)
+        : coro_hndl_{coro_hndl}
+    { }
+
+    PooledTask(const PooledTask&) = delete;
+    PooledTask& operator=(const PooledTask&) = delete;
+
+    ~PooledTask()
+    {
+        if (coro_hndl_)
+            coro_hndl_.destroy();
+    }
+
+    void resume()
+    {
+        coro_hndl_.resume();
+    }
+
+private:
+    std::coroutine_handle<promise_type> coro_hndl_;
+};
+
+PooledTask pooled_coroutine(int& counter)
+{
+    ++counter;
+    co_return;
+}
+
+PooledTask arena_coroutine(std::allocator_arg_t, std::pmr::memory_resource*, int& counter)
+{
+    ++counter;
+    co_return;
+}
+
+TEST_CASE("pooled coroutine frames")
+{
+    coro::reset_frame_stats();
+    int counter = 0;
+
+    SECTION("frames are recycled from thread-local free lists")
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            auto task = pooled_coroutine(counter);
+            task.resume();
+        }
+
+        auto stats = coro::frame_stats();
+        CHECK(counter == 100);
+        CHECK(stats.created == 100);
+        CHECK(stats.allocated + stats.recycled + stats.elided() == 100);
+        CHECK(stats.allocated <= 1);
+    }
+
+    SECTION("frames can be allocated from caller-provided arena")
+    {
+        std::pmr::monotonic_buffer_resource arena;
+
+        for (int i = 0; i < 10; ++i)
+        {
+            auto task = arena_coroutine(std::allocator_arg, &arena, counter);
+            task.resume();
+        }
+
+        auto stats = coro::frame_stats();
+        CHECK(counter == 10);
+        CHECK(stats.arena + stats.elided() == 10);
+        CHECK(stats.allocated == 0);
+    }
+
+    SECTION("generator frames are pooled")
+    {
+        auto numbers = [](int n) -> coro::generator<int> {
+            for (int i = 0; i < n; ++i)
+                co_yield i;
+        };
+
+        for (int i = 0; i < 10; ++i)
+            for (int value : numbers(3))
+                counter += value;
+
+        auto stats = coro::frame_stats();
+        CHECK(counter == 30);
+        CHECK(stats.created == 10);
+        CHECK(stats.allocated <= 1);
+    }
+}
+
+TEST_CASE("pooled coroutine frames - free lists of a thread only freeing frames are capped")
+{
+    constexpr std::size_t count = 1'000;
+    int counter = 0;
+
+    std::vector<std::unique_ptr<PooledTask>> tasks;
+    for (std::size_t i = 0; i < count; ++i)
+        tasks.emplace_back(new PooledTask{pooled_coroutine(counter)});
+
+    coro::FrameStats consumer_stats;
+    std::thread{[&] {
+        tasks.clear(); // frames allocated on the main thread are freed here
+        consumer_stats = coro::frame_stats();
+    }}.join();
+
+    CHECK(consumer_stats.allocated == 0);
+    CHECK(consumer_stats.released == count - coro::detail::FramePool::max_cached_per_class);
+}
+
+namespace
+{
+    // runs a pooled coroutine from its destructor - during thread exit, after the frame pool of the thread is gone
+    struct CoroutineAtThreadExit
+    {
+        int& counter;
+
+        ~CoroutineAtThreadExit()
+        {
+            auto task = pooled_coroutine(counter);
+            task.resume();
+        }
+    };
+} // namespace
+
+TEST_CASE("pooled coroutine frames - coroutines created after the pool of the thread is destroyed")
+{
+    int counter = 0;
+
+    std::thread{[&] {
+        thread_local CoroutineAtThreadExit at_exit{counter}; // constructed before the pool - destroyed after it
+
+        auto task = pooled_coroutine(counter);
+        task.resume();
+    }}.join();
+
+    CHECK(counter == 2);
+}
+
+TEST_CASE("pooled coroutine frames - frame allocated after the pool is destroyed can be reused by another thread")
+{
+    constexpr std::size_t size = 8;
+    void* frame = nullptr;
+
+    struct AllocateAtThreadExit
+    {
+        void*& frame;
+
+        ~AllocateAtThreadExit()
+        {
+            frame = coro::PooledFramePromise::operator new(size);
+        }
+    };
+
+    std::thread{[&] {
+        thread_local AllocateAtThreadExit at_exit{frame}; // constructed before the pool - destroyed after it
+        coro::frame_stats();
+    }}.join();
+
+    REQUIRE(frame != nullptr);
+    coro::PooledFramePromise::operator delete(frame, size); // cached by the pool of this thread
+
+    // the largest frame of the same size class - may be served with the cached block
+    constexpr std::size_t max_size = 64 - alignof(std::max_align_t);
+    void* reused = coro::PooledFramePromise::operator new(max_size);
+    std::memset(reused, 0xAB, max_size);
+    coro::PooledFramePromise::operator delete(reused, max_size);
+}
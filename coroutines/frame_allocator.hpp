@@ -0,0 +1,200 @@
+#ifndef FRAME_ALLOCATOR_HPP
+#define FRAME_ALLOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+namespace coro
+{
+    // Frame allocation counters of the calling thread
+    struct FrameStats
+    {
+        std::size_t created = 0;   // coroutine calls (promise constructions)
+        std::size_t allocated = 0; // frames allocated with ::operator new
+        std::size_t recycled = 0;  // frames served from the thread-local free lists
+        std::size_t arena = 0;     // frames allocated from caller-provided memory resources
+        std::size_t released = 0;  // frames freed with ::operator delete - free list of their size class was full
+
+        // frames that never reached operator new - allocation elided by the compiler (HALO)
+        std::size_t elided() const noexcept
+        {
+            return created - allocated - recycled - arena;
+        }
+    };
+
+    namespace detail
+    {
+        // Thread-local free lists of frames in size classes of 64 bytes (up to 1 KiB).
+        // A frame freed on another thread goes to the list of the freeing thread - lists are capped,
+        // so a thread that only frees frames (consumer of a channel, timer thread) doesn't hoard memory.
+        class FramePool
+        {
+        public:
+            static constexpr std::size_t max_cached_per_class = 256;
+
+        private:
+            static constexpr std::size_t granularity = 64;
+            static constexpr std::size_t class_count = 16;
+
+            struct FreeBlock
+            {
+                FreeBlock* next;
+            };
+
+            std::array<FreeBlock*, class_count> free_lists_{};
+            std::array<std::size_t, class_count> cached_{};
+
+            inline static thread_local bool destroyed_ = false;
+
+        public:
+            FrameStats stats;
+
+            FramePool() = default;
+            FramePool(const FramePool&) = delete;
+            FramePool& operator=(const FramePool&) = delete;
+
+            ~FramePool()
+            {
+                for (auto* head : free_lists_)
+                    while (head)
+                        ::operator delete(std::exchange(head, head->next));
+
+                destroyed_ = true;
+            }
+
+            static bool destroyed() noexcept
+            {
+                return destroyed_;
+            }
+
+            // Block that can be cached by any pool - rounded up to its size class.
+            // Used directly once the pool of the thread is destroyed: the block may be freed
+            // to a pool of another thread and handed out for any frame of its size class.
+            static void* allocate_block(std::size_t size)
+            {
+                const std::size_t size_class = (size - 1) / granularity;
+                return ::operator new(size_class < class_count ? (size_class + 1) * granularity : size);
+            }
+
+            void* allocate(std::size_t size)
+            {
+                const std::size_t size_class = (size - 1) / granularity;
+
+                if (size_class < class_count)
+                {
+                    if (auto* block = free_lists_[size_class])
+                    {
+                        free_lists_[size_class] = block->next;
+                        --cached_[size_class];
+                        ++stats.recycled;
+                        return block;
+                    }
+                }
+
+                ++stats.allocated;
+                return allocate_block(size);
+            }
+
+            void deallocate(void* ptr, std::size_t size) noexcept
+            {
+                const std::size_t size_class = (size - 1) / granularity;
+
+                if (size_class < class_count && cached_[size_class] < max_cached_per_class)
+                {
+                    auto* block = static_cast<FreeBlock*>(ptr);
+                    block->next = free_lists_[size_class];
+                    free_lists_[size_class] = block;
+                    ++cached_[size_class];
+                }
+                else
+                {
+                    if (size_class < class_count)
+                        ++stats.released;
+                    ::operator delete(ptr);
+                }
+            }
+        };
+
+        inline FramePool& frame_pool()
+        {
+            thread_local FramePool pool;
+            return pool;
+        }
+
+        // nullptr once the pool of the calling thread is destroyed - coroutines created or destroyed
+        // by destructors of other thread_local objects during thread exit bypass the pool
+        inline FramePool* live_frame_pool() noexcept
+        {
+            return FramePool::destroyed() ? nullptr : &frame_pool();
+        }
+    } // namespace detail
+
+    inline FrameStats frame_stats()
+    {
+        return detail::frame_pool().stats;
+    }
+
+    inline void reset_frame_stats()
+    {
+        detail::frame_pool().stats = FrameStats{};
+    }
+
+    // Base class for promise types - coroutine frames are allocated from thread-local pools.
+    // A coroutine taking (std::allocator_arg_t, std::pmr::memory_resource*, ...) as its first
+    // parameters allocates its frame from the given memory resource instead.
+    class PooledFramePromise
+    {
+        // every frame is prefixed with the memory resource it came from (nullptr - pool)
+        static constexpr std::size_t header_size = alignof(std::max_align_t);
+
+        static void* with_header(void* block, std::pmr::memory_resource* resource) noexcept
+        {
+            *static_cast<std::pmr::memory_resource**>(block) = resource;
+            return static_cast<std::byte*>(block) + header_size;
+        }
+
+    public:
+        PooledFramePromise() noexcept
+        {
+            if (auto* pool = detail::live_frame_pool())
+                ++pool->stats.created;
+        }
+
+        static void* operator new(std::size_t size)
+        {
+            auto* pool = detail::live_frame_pool();
+            void* block = pool ? pool->allocate(size + header_size) : detail::FramePool::allocate_block(size + header_size);
+            return with_header(block, nullptr);
+        }
+
+        // Frames are freed by the usual operator delete below, which finds the memory resource in the header.
+        // Inlined - GCC doesn't pair a template operator new with a non-template operator delete
+        // and reports -Wmismatched-new-delete at every arena coroutine.
+        template <typename... TArgs>
+        [[gnu::always_inline]] static void* operator new(std::size_t size, std::allocator_arg_t, std::pmr::memory_resource* resource, TArgs&...)
+        {
+            if (auto* pool = detail::live_frame_pool())
+                ++pool->stats.arena;
+            return with_header(resource->allocate(size + header_size, header_size), resource);
+        }
+
+        static void operator delete(void* ptr, std::size_t size) noexcept
+        {
+            void* block = static_cast<std::byte*>(ptr) - header_size;
+            auto* resource = *static_cast<std::pmr::memory_resource**>(block);
+
+            if (resource)
+                resource->deallocate(block, size + header_size, header_size);
+            else if (auto* pool = detail::live_frame_pool())
+                pool->deallocate(block, size + header_size);
+            else
+                ::operator delete(block);
+        }
+    };
+} // namespace coro
+
+#endif
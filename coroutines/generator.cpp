@@ -0,0 +1,357 @@
+#include "generator.hpp"
+
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if __has_include(<generator>)
+#include <generator>
+#endif
+
+using namespace std::literals;
+
+static_assert(std::ranges::input_range<coro::generator<int>>);
+static_assert(std::ranges::view<coro::generator<int>>);
+
+coro::generator<int> iota(int start, int end)
+{
+    for (int i = start; i < end; ++i)
+        co_yield i;
+}
+
+TEST_CASE("generator - yields lazy sequence")
+{
+    std::vector<int> values;
+
+    for (int value : iota(1, 6))
+        values.push_back(value);
+
+    CHECK(values == std::vector{1, 2, 3, 4, 5});
+}
+
+TEST_CASE("generator - composes with views")
+{
+    auto evens = iota(0, 1'000'000) | std::views::filter([](int n) { return n % 2 == 0; }) | std::views::take(3);
+
+    std::vector<int> values;
+    std::ranges::copy(evens, std::back_inserter(values));
+
+    CHECK(values == std::vector{0, 2, 4});
+}
+
+struct CopyCounter
+{
+    inline static int copies = 0;
+
+    int value;
+
+    CopyCounter(int v)
+        : value{v}
+    { }
+
+    CopyCounter(const CopyCounter& other)
+        : value{other.value}
+    {
+        ++copies;
+    }
+};
+
+coro::generator<CopyCounter> counters()
+{
+    CopyCounter local{1};
+    co_yield local;
+    co_yield CopyCounter{2};
+}
+
+coro::generator<std::string&> words(std::vector<std::string>& source)
+{
+    for (auto& word : source)
+        co_yield word;
+}
+
+TEST_CASE("generator - yields references without copies")
+{
+    CopyCounter::copies = 0;
+
+    int sum = 0;
+    for (const CopyCounter& counter : counters())
+        sum += counter.value;
+
+    CHECK(sum == 3);
+    CHECK(CopyCounter::copies == 0);
+
+    SECTION("mutable references")
+    {
+        std::vector<std::string> source = {"one", "two"};
+
+        for (std::string& word : words(source))
+            word += "!";
+
+        CHECK(source == std::vector{"one!"s, "two!"s});
+    }
+}
+
+coro::generator<int> nested_sequence()
+{
+    co_yield 1;
+    co_yield coro::elements_of(iota(2, 4));
+    co_yield coro::elements_of(coro::generator<int>{}); // empty generator
+    co_yield 4;
+
+    auto tail = iota(5, 7);
+    co_yield coro::elements_of(tail);
+
+    auto exhausted = iota(7, 9);
+    for ([[maybe_unused]] int value : exhausted)
+    { }
+    co_yield coro::elements_of(exhausted); // yields nothing
+}
+
+TEST_CASE("generator - nested generators")
+{
+    std::vector<int> values;
+
+    for (int value : nested_sequence())
+        values.push_back(value);
+
+    CHECK(values == std::vector{1, 2, 3, 4, 5, 6});
+}
+
+coro::generator<int> throwing_generator()
+{
+    co_yield 1;
+    throw std::runtime_error("generator error");
+}
+
+coro::generator<int> catching_generator()
+{
+    bool failed = false;
+
+    try
+    {
+        co_yield coro::elements_of(throwing_generator());
+    }
+    catch (const std::runtime_error&)
+    {
+        failed = true; // co_yield is not allowed in a handler
+    }
+
+    if (failed)
+        co_yield -1;
+}
+
+TEST_CASE("generator - exceptions")
+{
+    SECTION("are rethrown to consumer")
+    {
+        auto gen = throwing_generator();
+        auto it = gen.begin();
+
+        CHECK(*it == 1);
+        CHECK_THROWS_AS(++it, std::runtime_error);
+    }
+
+    SECTION("are propagated from nested generator to parent")
+    {
+        std::vector<int> values;
+
+        for (int value : catching_generator())
+            values.push_back(value);
+
+        CHECK(values == std::vector{1, -1});
+    }
+}
+
+struct TreeNode
+{
+    int value;
+    std::vector<TreeNode> children;
+};
+
+// pre-order traversal - every element is yielded from the leaf frame directly to the consumer
+coro::generator<int> traverse(const TreeNode& node)
+{
+    co_yield node.value;
+    for (const auto& child : node.children)
+        co_yield coro::elements_of(traverse(child));
+}
+
+// nested generators re-yielding elements of children - every element passes through all frames above it
+coro::generator<int> traverse_naive(const TreeNode& node)
+{
+    co_yield node.value;
+    for (const auto& child : node.children)
+        for (int value : traverse_naive(child))
+            co_yield value;
+}
+
+TreeNode make_chain(int depth)
+{
+    TreeNode root{0, {}};
+    TreeNode* node = &root;
+    for (int i = 1; i < depth; ++i)
+        node = &node->children.emplace_back(TreeNode{i, {}});
+    return root;
+}
+
+TEST_CASE("generator - recursive traversal of a tree")
+{
+    const TreeNode tree{1, {{2, {{3, {}}, {4, {}}}}, {5, {}}, {6, {{7, {{8, {}}}}}}}};
+
+    std::vector<int> values;
+    for (int value : traverse(tree))
+        values.push_back(value);
+
+    CHECK(values == std::vector{1, 2, 3, 4, 5, 6, 7, 8});
+
+    SECTION("deep nesting")
+    {
+        constexpr int depth = 10'000;
+        const auto chain = make_chain(depth);
+
+        std::vector<int> values;
+        for (int value : traverse(chain))
+            values.push_back(value);
+
+        REQUIRE(values.size() == depth);
+        CHECK(values.back() == depth - 1);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////
+// Benchmark
+
+// squares are computed in 64 bits - i * i overflows int for i > 46340
+class SquaresRange
+{
+    std::int64_t count_;
+
+public:
+    class iterator
+    {
+        std::int64_t i_;
+
+    public:
+        using value_type = std::int64_t;
+        using difference_type = std::ptrdiff_t;
+
+        explicit iterator(std::int64_t i = 0)
+            : i_{i}
+        { }
+
+        std::int64_t operator*() const
+        {
+            return i_ * i_;
+        }
+
+        iterator& operator++()
+        {
+            ++i_;
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++i_;
+            return tmp;
+        }
+
+        bool operator==(const iterator&) const = default;
+    };
+
+    explicit SquaresRange(std::int64_t count)
+        : count_{count}
+    { }
+
+    iterator begin() const
+    {
+        return iterator{0};
+    }
+
+    iterator end() const
+    {
+        return iterator{count_};
+    }
+};
+
+coro::generator<std::int64_t> squares(std::int64_t count)
+{
+    for (std::int64_t i = 0; i < count; ++i)
+        co_yield i * i;
+}
+
+#if defined(__cpp_lib_generator)
+std::generator<std::int64_t> std_squares(std::int64_t count)
+{
+    for (std::int64_t i = 0; i < count; ++i)
+        co_yield i * i;
+}
+#endif
+
+TEST_CASE("generator benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+
+    constexpr int count = 1'000'000;
+
+    auto sum_of = [](auto&& rng) {
+        std::int64_t sum = 0;
+        for (auto value : rng)
+            sum += value;
+        return sum;
+    };
+
+    bm::run("hand-written iterator", count, [&] { bm::do_not_optimize(sum_of(SquaresRange{count})); });
+    bm::run("coro::generator", count, [&] { bm::do_not_optimize(sum_of(squares(count))); });
+#if defined(__cpp_lib_generator)
+    bm::run("std::generator", count, [&] { bm::do_not_optimize(sum_of(std_squares(count))); });
+#endif
+}
+
+// spine of `depth` nodes, every spine node has the same number of leaves - node_count nodes in total
+TreeNode make_comb(int depth, int node_count)
+{
+    const int leaves_per_node = node_count / depth - 1;
+
+    auto root = make_chain(depth);
+    TreeNode* node = &root;
+    while (true)
+    {
+        auto* spine_child = node->children.empty() ? nullptr : &node->children.front();
+        for (int i = 0; i < leaves_per_node; ++i)
+            node->children.push_back(TreeNode{i, {}});
+        if (!spine_child)
+            break;
+        node = &node->children.front(); // push_back may have reallocated
+    }
+    return root;
+}
+
+TEST_CASE("recursive generator benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+
+    constexpr int node_count = 1'000'000;
+
+    auto sum_of = [](auto&& rng) {
+        long sum = 0;
+        for (auto value : rng)
+            sum += value;
+        return sum;
+    };
+
+    for (int depth : {10, 100})
+    {
+        const auto tree = make_comb(depth, node_count);
+        const auto suffix = " - depth " + std::to_string(depth);
+
+        bm::run("elements_of" + suffix, node_count, [&] { bm::do_not_optimize(sum_of(traverse(tree))); }, 3);
+        bm::run("nested re-yield" + suffix, node_count, [&] { bm::do_not_optimize(sum_of(traverse_naive(tree))); }, 3);
+    }
+}
@@ -0,0 +1,239 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include "frame_allocator.hpp"
+
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+namespace coro
+{
+    // Wrapper for co_yield of a nested generator: co_yield coro::elements_of(child());
+    template <typename Gen>
+    struct elements_of
+    {
+        Gen range; // reference - a temporary generator lives until the end of co_yield expression
+
+        explicit elements_of(Gen&& gen) noexcept
+            : range{std::forward<Gen>(gen)}
+        { }
+    };
+
+    template <typename Gen>
+    elements_of(Gen&&) -> elements_of<Gen&&>;
+
+    // Lazy sequence of values produced by a coroutine.
+    //  - yielded values are passed by reference (no copies are made)
+    //  - nested generators yielded with elements_of are resumed directly by the consumer
+    //    (control is passed between frames with symmetric transfer)
+    //  - exceptions escaping the coroutine are rethrown to the consumer
+    template <typename T>
+    class generator : public std::ranges::view_interface<generator<T>>
+    {
+    public:
+        using value_type = std::remove_cvref_t<T>;
+        using reference = std::conditional_t<std::is_reference_v<T>, T, const T&>;
+
+        struct promise_type;
+        using CoroHandle = std::coroutine_handle<promise_type>;
+
+        struct promise_type : PooledFramePromise
+        {
+            std::add_pointer_t<reference> value_ = nullptr;
+            std::exception_ptr exception_;
+            promise_type* root_ = this;
+            promise_type* leaf_ = this; // frame that is resumed by the consumer (used in root only)
+            promise_type* parent_ = nullptr;
+
+            CoroHandle handle() noexcept
+            {
+                return CoroHandle::from_promise(*this);
+            }
+
+            generator get_return_object() noexcept
+            {
+                return generator{handle()};
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            auto final_suspend() noexcept
+            {
+                struct FinalAwaiter
+                {
+                    bool await_ready() noexcept
+                    {
+                        return false;
+                    }
+
+                    std::coroutine_handle<> await_suspend(CoroHandle coro) noexcept
+                    {
+                        auto& promise = coro.promise();
+                        if (promise.parent_)
+                        {
+                            promise.root_->leaf_ = promise.parent_;
+                            return promise.parent_->handle();
+                        }
+                        return std::noop_coroutine();
+                    }
+
+                    void await_resume() noexcept
+                    { }
+                };
+
+                return FinalAwaiter{};
+            }
+
+            std::suspend_always yield_value(reference value) noexcept
+            {
+                root_->value_ = std::addressof(value);
+                return {};
+            }
+
+            template <typename Gen>
+                requires std::same_as<std::remove_cvref_t<Gen>, generator>
+            auto yield_value(elements_of<Gen> nested) noexcept
+            {
+                struct NestedAwaiter
+                {
+                    generator& gen;
+
+                    bool await_ready() noexcept
+                    {
+                        return !gen.coro_hndl_ || gen.coro_hndl_.done(); // empty or already exhausted
+                    }
+
+                    std::coroutine_handle<> await_suspend(CoroHandle coro) noexcept
+                    {
+                        auto& parent = coro.promise();
+                        auto& child = gen.coro_hndl_.promise();
+
+                        child.parent_ = &parent;
+                        child.root_ = parent.root_;
+                        parent.root_->leaf_ = &child;
+
+                        return gen.coro_hndl_;
+                    }
+
+                    void await_resume()
+                    {
+                        if (gen.coro_hndl_ && gen.coro_hndl_.promise().exception_)
+                            std::rethrow_exception(gen.coro_hndl_.promise().exception_);
+                    }
+                };
+
+                return NestedAwaiter{nested.range};
+            }
+
+            template <typename U>
+            void await_transform(U&&) = delete; // co_await is not allowed in generators
+
+            void return_void() noexcept
+            { }
+
+            void unhandled_exception() noexcept
+            {
+                exception_ = std::current_exception();
+            }
+        };
+
+        class iterator
+        {
+            CoroHandle coro_hndl_;
+
+        public:
+            using value_type = generator::value_type;
+            using difference_type = std::ptrdiff_t;
+
+            iterator() = default;
+
+            explicit iterator(CoroHandle coro_hndl) noexcept
+                : coro_hndl_{coro_hndl}
+            { }
+
+            reference operator*() const noexcept
+            {
+                return static_cast<reference>(*coro_hndl_.promise().value_);
+            }
+
+            iterator& operator++()
+            {
+                advance(coro_hndl_);
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            bool operator==(std::default_sentinel_t) const noexcept
+            {
+                return !coro_hndl_ || coro_hndl_.done();
+            }
+        };
+
+        generator() = default;
+
+        generator(generator&& other) noexcept
+            : coro_hndl_{std::exchange(other.coro_hndl_, {})}
+        { }
+
+        generator& operator=(generator&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (coro_hndl_)
+                    coro_hndl_.destroy();
+                coro_hndl_ = std::exchange(other.coro_hndl_, {});
+            }
+            return *this;
+        }
+
+        ~generator()
+        {
+            if (coro_hndl_)
+                coro_hndl_.destroy();
+        }
+
+        iterator begin()
+        {
+            if (coro_hndl_)
+                advance(coro_hndl_);
+            return iterator{coro_hndl_};
+        }
+
+        std::default_sentinel_t end() const noexcept
+        {
+            return std::default_sentinel;
+        }
+
+    private:
+        CoroHandle coro_hndl_;
+
+        explicit generator(CoroHandle coro_hndl) noexcept
+            : coro_hndl_{coro_hndl}
+        { }
+
+        static void advance(CoroHandle root)
+        {
+            auto& promise = root.promise();
+            promise.leaf_->handle().resume();
+
+            if (promise.exception_)
+                std::rethrow_exception(std::exchange(promise.exception_, nullptr));
+        }
+    };
+} // namespace coro
+
+#endif
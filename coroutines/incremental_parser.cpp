@@ -0,0 +1,216 @@
+#include "incremental_parser.hpp"
+
+#include <algorithm>
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    std::span<const std::byte> as_bytes(std::string_view text)
+    {
+        return std::as_bytes(std::span{text});
+    }
+
+    std::string_view as_string(std::span<const std::byte> bytes)
+    {
+        return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+    }
+
+    std::uint32_t load_u32(std::span<const std::byte> bytes)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, bytes.data(), sizeof(value));
+        return value;
+    }
+
+    // Record stream: [uint32 payload length][payload]...
+    std::vector<std::byte> make_record_stream(std::size_t record_count, std::uint32_t seed = 665)
+    {
+        std::mt19937 rnd{seed};
+        std::uniform_int_distribution<std::uint32_t> size_distr{16, 256};
+
+        std::vector<std::byte> stream;
+        for (std::size_t i = 0; i < record_count; ++i)
+        {
+            const std::uint32_t size = size_distr(rnd);
+            const auto* size_bytes = reinterpret_cast<const std::byte*>(&size);
+            stream.insert(stream.end(), size_bytes, size_bytes + sizeof(size));
+            stream.insert(stream.end(), size, static_cast<std::byte>(i));
+        }
+        return stream;
+    }
+} // namespace
+
+// zero-copy records - payload is a view into the chunk (or into the parser buffer)
+coro::parser<std::span<const std::byte>> record_parser()
+{
+    while (true)
+    {
+        const auto size = load_u32(co_await coro::read_bytes{sizeof(std::uint32_t)});
+        co_yield co_await coro::read_bytes{size};
+    }
+}
+
+coro::parser<std::string> line_parser(std::size_t max_length)
+{
+    while (true)
+    {
+        auto line = co_await coro::read_until{std::byte{'\n'}, max_length};
+        co_yield std::string{as_string(line.first(line.size() - 1))};
+    }
+}
+
+TEST_CASE("incremental parser - lines split across chunks")
+{
+    auto parser = line_parser(100);
+
+    std::vector<std::string> lines;
+    for (auto chunk : {"GET / HT"sv, "TP/1.1\nHost: exa"sv, "mple.com\n\nrest"sv})
+    {
+        parser.feed(as_bytes(chunk));
+        while (auto line = parser.next())
+            lines.push_back(*line);
+    }
+
+    CHECK(lines == std::vector{"GET / HTTP/1.1"s, "Host: example.com"s, ""s});
+    CHECK(parser.has_partial_input());
+}
+
+TEST_CASE("incremental parser - errors are rethrown to the caller")
+{
+    auto parser = line_parser(4);
+
+    parser.feed(as_bytes("abc\nabcdef\n"));
+
+    CHECK(parser.next() == "abc");
+    CHECK_THROWS_AS(parser.next(), std::length_error);
+    CHECK(parser.done());
+}
+
+TEST_CASE("incremental parser - input without delimiter is not buffered beyond max_length")
+{
+    auto parser = line_parser(8);
+
+    parser.feed(as_bytes("abc"));
+    CHECK(parser.next() == std::nullopt);
+    parser.feed(as_bytes("defg"));
+    CHECK(parser.next() == std::nullopt);
+    CHECK(parser.has_partial_input());
+
+    parser.feed(as_bytes("hi")); // 9 bytes and no delimiter yet
+    CHECK_THROWS_AS(parser.next(), std::length_error);
+    CHECK(parser.done());
+}
+
+TEST_CASE("incremental parser - line of max_length including delimiter is accepted")
+{
+    auto parser = line_parser(8);
+
+    parser.feed(as_bytes("abcd"));
+    CHECK(parser.next() == std::nullopt);
+    parser.feed(as_bytes("efg\n"));
+    CHECK(parser.next() == "abcdefg");
+}
+
+TEST_CASE("incremental parser - records")
+{
+    const auto stream = make_record_stream(100);
+
+    for (std::size_t chunk_size : {1, 3, 7, 64, 1500, 100'000})
+    {
+        auto parser = record_parser();
+        std::vector<std::size_t> sizes;
+        std::size_t zero_copy = 0;
+
+        for (std::size_t offset = 0; offset < stream.size(); offset += chunk_size)
+        {
+            const auto chunk = std::span{stream}.subspan(offset, std::min(chunk_size, stream.size() - offset));
+
+            parser.feed(chunk);
+            while (auto record = parser.next())
+            {
+                REQUIRE(std::ranges::all_of(*record, [&](std::byte b) { return b == static_cast<std::byte>(sizes.size()); }));
+                sizes.push_back(record->size());
+
+                if (record->data() >= chunk.data() && record->data() < chunk.data() + chunk.size())
+                    ++zero_copy;
+            }
+        }
+
+        CHECK(sizes.size() == 100);
+        CHECK_FALSE(parser.has_partial_input());
+
+        if (chunk_size == 100'000)
+            CHECK(zero_copy == 100);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////
+// Benchmark
+
+// Baseline - every chunk is appended to a buffer, complete records are extracted from it
+class BufferingRecordParser
+{
+    std::vector<std::byte> buffer_;
+    std::size_t offset_ = 0;
+
+public:
+    template <typename F>
+    void feed(std::span<const std::byte> chunk, F&& on_record)
+    {
+        buffer_.insert(buffer_.end(), chunk.begin(), chunk.end());
+
+        while (buffer_.size() - offset_ >= sizeof(std::uint32_t))
+        {
+            const auto size = load_u32(std::span{buffer_}.subspan(offset_));
+            if (buffer_.size() - offset_ - sizeof(std::uint32_t) < size)
+                break;
+
+            on_record(std::span{buffer_}.subspan(offset_ + sizeof(std::uint32_t), size));
+            offset_ += sizeof(std::uint32_t) + size;
+        }
+
+        buffer_.erase(buffer_.begin(), buffer_.begin() + offset_);
+        offset_ = 0;
+    }
+};
+
+TEST_CASE("incremental parser benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+
+    constexpr std::size_t record_count = 100'000;
+    const auto stream = make_record_stream(record_count);
+
+    for (std::size_t chunk_size : {1500, 64 * 1024})
+    {
+        const auto suffix = " - " + std::to_string(chunk_size) + " B chunks";
+
+        bm::run("buffering parser" + suffix, record_count, [&] {
+            BufferingRecordParser parser;
+            for (std::size_t offset = 0; offset < stream.size(); offset += chunk_size)
+                parser.feed(std::span{stream}.subspan(offset, std::min(chunk_size, stream.size() - offset)),
+                    [](std::span<const std::byte> record) { bm::do_not_optimize(record.size()); });
+        });
+
+        bm::run("coroutine parser" + suffix, record_count, [&] {
+            auto parser = record_parser();
+            for (std::size_t offset = 0; offset < stream.size(); offset += chunk_size)
+            {
+                parser.feed(std::span{stream}.subspan(offset, std::min(chunk_size, stream.size() - offset)));
+                while (auto record = parser.next())
+                    bm::do_not_optimize(record->size());
+            }
+        });
+    }
+}
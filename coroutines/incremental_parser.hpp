@@ -0,0 +1,301 @@
+#ifndef INCREMENTAL_PARSER_HPP
+#define INCREMENTAL_PARSER_HPP
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace coro
+{
+    // Input requests awaited inside a parser coroutine:
+    //   auto header = co_await coro::read_bytes{4};
+    //   auto line = co_await coro::read_until{std::byte{'\n'}};
+    // The returned span is valid until the next co_await in the parser.
+    // read_until throws std::length_error if the delimiter is not found within max_length bytes -
+    // input without the delimiter is not buffered beyond that.
+    struct read_bytes
+    {
+        std::size_t count;
+    };
+
+    struct read_until
+    {
+        std::byte delimiter; // included in the returned span
+        std::size_t max_length = std::numeric_limits<std::size_t>::max(); // including the delimiter
+    };
+
+    struct read_some
+    {
+    };
+
+    // Resumable parser of a chunked byte stream. Parsed messages are produced with co_yield.
+    //  - a parser coroutine suspends when a request can't be satisfied by the current chunk
+    //    and is resumed when the next chunk is fed
+    //  - requests that fit in the current chunk return views into the chunk (no copies);
+    //    only requests crossing a chunk boundary are assembled in an internal buffer
+    // Usage:
+    //   parser.feed(chunk);
+    //   while (auto message = parser.next())
+    //       handle(*message);
+    template <typename T>
+    class parser
+    {
+    public:
+        struct promise_type;
+        using CoroHandle = std::coroutine_handle<promise_type>;
+
+        struct promise_type
+        {
+            enum class Request
+            {
+                none,
+                bytes,
+                until,
+                some
+            };
+
+            std::span<const std::byte> input_; // unconsumed part of the current chunk
+            std::vector<std::byte> scratch_;   // request crossing chunk boundaries
+            std::span<const std::byte> result_;
+            Request request_ = Request::none;
+            std::size_t count_ = 0; // read_bytes: size, read_until: max_length
+            std::byte delimiter_{};
+            bool too_long_ = false; // read_until exceeded count_
+            std::optional<T> message_;
+            std::exception_ptr exception_;
+
+            parser get_return_object()
+            {
+                return parser{CoroHandle::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always yield_value(T message)
+            {
+                message_.emplace(std::move(message));
+                return {};
+            }
+
+            void return_void() noexcept
+            { }
+
+            void unhandled_exception() noexcept
+            {
+                exception_ = std::current_exception();
+            }
+
+            struct InputAwaiter
+            {
+                promise_type& promise;
+
+                bool await_ready()
+                {
+                    return promise.try_read();
+                }
+
+                void await_suspend(CoroHandle) noexcept
+                { }
+
+                std::span<const std::byte> await_resume()
+                {
+                    promise.request_ = Request::none;
+                    if (std::exchange(promise.too_long_, false))
+                        throw std::length_error("Delimiter not found within max_length");
+                    return promise.result_;
+                }
+            };
+
+            InputAwaiter await_transform(read_bytes request)
+            {
+                return start_request(Request::bytes, request.count);
+            }
+
+            InputAwaiter await_transform(read_until request)
+            {
+                delimiter_ = request.delimiter;
+                return start_request(Request::until, request.max_length);
+            }
+
+            InputAwaiter await_transform(read_some)
+            {
+                return start_request(Request::some);
+            }
+
+            InputAwaiter start_request(Request request, std::size_t count = 0)
+            {
+                request_ = request;
+                count_ = count;
+                scratch_.clear();
+                return InputAwaiter{*this};
+            }
+
+            // Completes the pending request from the current chunk - false if more input is needed
+            bool try_read()
+            {
+                switch (request_)
+                {
+                case Request::bytes:
+                {
+                    if (scratch_.empty() && input_.size() >= count_)
+                        return complete_from_input(count_);
+
+                    const auto n = std::min(count_ - scratch_.size(), input_.size());
+                    append_to_scratch(n);
+                    return scratch_.size() == count_ && complete_from_scratch();
+                }
+                case Request::until:
+                {
+                    const auto pos = std::ranges::find(input_, delimiter_);
+                    if (pos == input_.end())
+                    {
+                        if (input_.size() >= count_ - scratch_.size()) // no room left for the delimiter
+                            return fail_too_long();
+                        append_to_scratch(input_.size());
+                        return false;
+                    }
+
+                    const auto n = static_cast<std::size_t>(pos - input_.begin()) + 1;
+                    if (n > count_ - scratch_.size())
+                        return fail_too_long();
+                    if (scratch_.empty())
+                        return complete_from_input(n);
+
+                    append_to_scratch(n);
+                    return complete_from_scratch();
+                }
+                case Request::some:
+                    return !input_.empty() && complete_from_input(input_.size());
+                case Request::none:
+                    break;
+                }
+
+                return true;
+            }
+
+        private:
+            bool complete_from_input(std::size_t n) noexcept
+            {
+                result_ = input_.first(n);
+                input_ = input_.subspan(n);
+                return true;
+            }
+
+            bool complete_from_scratch() noexcept
+            {
+                result_ = scratch_;
+                return true;
+            }
+
+            // completes the request with an error - the unconsumed input is left for the parser
+            bool fail_too_long() noexcept
+            {
+                scratch_.clear();
+                scratch_.shrink_to_fit();
+                too_long_ = true;
+                return true;
+            }
+
+            void append_to_scratch(std::size_t n)
+            {
+                scratch_.insert(scratch_.end(), input_.begin(), input_.begin() + n);
+                input_ = input_.subspan(n);
+            }
+        };
+
+        parser(parser&& other) noexcept
+            : coro_hndl_{std::exchange(other.coro_hndl_, {})}
+        { }
+
+        parser& operator=(parser&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (coro_hndl_)
+                    coro_hndl_.destroy();
+                coro_hndl_ = std::exchange(other.coro_hndl_, {});
+            }
+            return *this;
+        }
+
+        ~parser()
+        {
+            if (coro_hndl_)
+                coro_hndl_.destroy();
+        }
+
+        // The chunk must stay alive until next() returns std::nullopt.
+        // Messages holding views into the input are valid until the following call to next().
+        void feed(std::span<const std::byte> chunk)
+        {
+            auto& promise = coro_hndl_.promise();
+
+            if (!promise.input_.empty())
+                throw std::logic_error("Previous chunk has not been consumed");
+
+            promise.input_ = chunk;
+        }
+
+        // Next parsed message or std::nullopt if the parser needs more input (or is done)
+        std::optional<T> next()
+        {
+            auto& promise = coro_hndl_.promise();
+
+            while (!coro_hndl_.done())
+            {
+                if (!promise.try_read())
+                    return std::nullopt;
+
+                coro_hndl_.resume();
+
+                if (promise.exception_)
+                    std::rethrow_exception(std::exchange(promise.exception_, nullptr));
+
+                if (promise.message_)
+                {
+                    std::optional<T> message = std::move(promise.message_);
+                    promise.message_.reset();
+                    return message;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        bool done() const noexcept
+        {
+            return coro_hndl_.done();
+        }
+
+        // true if the parser is suspended in the middle of a request - e.g. a truncated stream
+        bool has_partial_input() const noexcept
+        {
+            const auto& promise = coro_hndl_.promise();
+            return !coro_hndl_.done() && promise.request_ != promise_type::Request::none && !promise.scratch_.empty();
+        }
+
+    private:
+        CoroHandle coro_hndl_;
+
+        explicit parser(CoroHandle coro_hndl) noexcept
+            : coro_hndl_{coro_hndl}
+        { }
+    };
+} // namespace coro
+
+#endif
@@ -0,0 +1,168 @@
+#include "detached_task.hpp"
+#include "priority_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <latch>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// occupies the only worker until the gate is opened
+coro::detached_task block_worker(coro::PriorityScheduler& scheduler, std::latch& started, std::latch& gate)
+{
+    co_await scheduler.schedule(coro::Priority::high);
+    started.count_down();
+    gate.wait();
+}
+
+coro::detached_task record(coro::PriorityScheduler& scheduler, coro::Priority priority, std::string name, std::vector<std::string>& order, std::latch& done)
+{
+    co_await scheduler.schedule(priority);
+    order.push_back(name); // single worker - no synchronization needed
+    done.count_down();
+}
+
+TEST_CASE("priority scheduler - higher lanes go first")
+{
+    coro::PriorityScheduler scheduler{1};
+    std::latch started{1};
+    std::latch gate{1};
+    std::latch done{5};
+    std::vector<std::string> order;
+
+    block_worker(scheduler, started, gate);
+    started.wait();
+
+    record(scheduler, coro::Priority::low, "low-1", order, done);
+    record(scheduler, coro::Priority::normal, "normal-1", order, done);
+    record(scheduler, coro::Priority::high, "high-1", order, done);
+    record(scheduler, coro::Priority::low, "low-2", order, done);
+    record(scheduler, coro::Priority::high, "high-2", order, done);
+
+    CHECK(scheduler.stats(coro::Priority::low).queue_depth == 2);
+    CHECK(scheduler.stats(coro::Priority::high).queue_depth == 2);
+
+    gate.count_down();
+    done.wait();
+
+    CHECK(order == std::vector<std::string>{"high-1", "high-2", "normal-1", "low-1", "low-2"});
+
+    const auto low_stats = scheduler.stats(coro::Priority::low);
+    CHECK(low_stats.queue_depth == 0);
+    CHECK(low_stats.max_queue_depth == 2);
+    CHECK(low_stats.resumed == 2);
+    CHECK(low_stats.promoted == 0);
+    CHECK(low_stats.max_wait >= low_stats.average_wait());
+    CHECK(low_stats.average_wait() > 0ns);
+}
+
+TEST_CASE("priority scheduler - starvation protection")
+{
+    coro::PriorityScheduler scheduler{1, {coro::PriorityScheduler::Clock::duration::max(), 1h, 1ms}};
+    std::latch started{1};
+    std::latch gate{1};
+    std::latch done{4};
+    std::vector<std::string> order;
+
+    block_worker(scheduler, started, gate);
+    started.wait();
+
+    record(scheduler, coro::Priority::low, "low", order, done);
+    record(scheduler, coro::Priority::normal, "normal", order, done);
+    std::this_thread::sleep_for(2ms); // low is overdue, normal is not
+    record(scheduler, coro::Priority::high, "high-1", order, done);
+    record(scheduler, coro::Priority::high, "high-2", order, done);
+
+    gate.count_down();
+    done.wait();
+
+    CHECK(order == std::vector<std::string>{"low", "high-1", "high-2", "normal"});
+    CHECK(scheduler.stats(coro::Priority::low).promoted == 1);
+    CHECK(scheduler.stats(coro::Priority::normal).promoted == 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark
+
+namespace
+{
+    void spin_for(std::chrono::nanoseconds duration)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < duration)
+        { }
+    }
+} // namespace
+
+// bulk recomputation - slices of CPU work, rescheduled until stopped
+coro::detached_task bulk_job(coro::PriorityScheduler& scheduler, const std::atomic<bool>& stop, std::latch& finished)
+{
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        co_await scheduler.schedule(coro::Priority::low);
+        spin_for(20us);
+    }
+    finished.count_down();
+}
+
+coro::detached_task interactive_request(coro::PriorityScheduler& scheduler, coro::Priority priority, std::int64_t& latency_ns, std::latch& done)
+{
+    const auto start = std::chrono::steady_clock::now();
+    co_await scheduler.schedule(priority);
+    latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    done.count_down();
+}
+
+TEST_CASE("priority scheduler benchmark", "[.benchmark]")
+{
+    constexpr int request_count = 2'000;
+    constexpr int bulk_jobs_per_thread = 16;
+    const auto thread_count = std::max(std::thread::hardware_concurrency(), 2u);
+
+    for (auto [name, priority] : {std::pair{"interactive in the bulk lane (FIFO)", coro::Priority::low},
+             std::pair{"interactive in the high lane", coro::Priority::high}})
+    {
+        coro::PriorityScheduler scheduler{thread_count};
+        std::atomic<bool> stop{false};
+        std::latch bulk_finished{static_cast<std::ptrdiff_t>(thread_count * bulk_jobs_per_thread)};
+
+        for (std::size_t i = 0; i < thread_count * bulk_jobs_per_thread; ++i)
+            bulk_job(scheduler, stop, bulk_finished);
+
+        std::vector<std::int64_t> latencies(request_count);
+        std::latch done{request_count};
+        for (auto& latency : latencies)
+        {
+            interactive_request(scheduler, priority, latency, done);
+            std::this_thread::sleep_for(100us);
+        }
+        done.wait();
+
+        const auto high_stats = scheduler.stats(priority);
+        const auto bulk_stats = scheduler.stats(coro::Priority::low);
+
+        stop = true;
+        bulk_finished.wait();
+
+        std::ranges::sort(latencies);
+        const auto percentile = [&](double p) {
+            return latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))] / 1000.0;
+        };
+
+        std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << percentile(0.5) << " us p50"
+                  << std::setw(10) << percentile(0.99) << " us p99"
+                  << " | lane avg wait " << high_stats.average_wait().count() / 1000.0 << " us"
+                  << " | bulk lane max depth " << bulk_stats.max_queue_depth
+                  << ", promoted " << bulk_stats.promoted << "\n";
+    }
+}
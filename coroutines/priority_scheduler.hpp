@@ -0,0 +1,217 @@
+#ifndef PRIORITY_SCHEDULER_HPP
+#define PRIORITY_SCHEDULER_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace coro
+{
+    enum class Priority : std::uint8_t
+    {
+        high,   // latency sensitive (interactive requests)
+        normal,
+        low     // bulk work
+    };
+
+    inline constexpr std::size_t priority_count = 3;
+
+    struct LaneStats
+    {
+        std::size_t queue_depth = 0;
+        std::size_t max_queue_depth = 0;
+        std::uint64_t resumed = 0;
+        std::uint64_t promoted = 0; // resumed ahead of higher lanes by the starvation protection
+        std::chrono::nanoseconds total_wait{0};
+        std::chrono::nanoseconds max_wait{0};
+
+        std::chrono::nanoseconds average_wait() const noexcept
+        {
+            return resumed ? total_wait / static_cast<std::int64_t>(resumed) : std::chrono::nanoseconds{0};
+        }
+    };
+
+    // Thread pool with priority lanes - co_await scheduler.schedule(Priority::high).
+    // Workers always take the oldest handle of the highest non-empty lane, unless the oldest
+    // handle of a lower lane has waited longer than the starvation limit of its lane.
+    // The lanes are shared by all workers - per-worker queues couldn't keep a global priority order.
+    class PriorityScheduler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using StarvationLimits = std::array<Clock::duration, priority_count>;
+
+        static constexpr StarvationLimits default_starvation_limits{
+            Clock::duration::max(), std::chrono::milliseconds{10}, std::chrono::milliseconds{100}};
+
+        explicit PriorityScheduler(std::size_t thread_count = std::thread::hardware_concurrency(),
+            const StarvationLimits& starvation_limits = default_starvation_limits)
+            : starvation_limits_{starvation_limits}
+        {
+            thread_count = std::max<std::size_t>(thread_count, 1);
+            threads_.reserve(thread_count);
+            for (std::size_t i = 0; i < thread_count; ++i)
+                threads_.emplace_back([this] { run(); });
+        }
+
+        PriorityScheduler(const PriorityScheduler&) = delete;
+        PriorityScheduler& operator=(const PriorityScheduler&) = delete;
+
+        // Handles that were not resumed before destruction are not destroyed
+        ~PriorityScheduler()
+        {
+            {
+                std::lock_guard lk{mtx_};
+                stop_ = true;
+            }
+            cv_.notify_all();
+            threads_.clear();
+        }
+
+        std::size_t thread_count() const noexcept
+        {
+            return threads_.size();
+        }
+
+        // co_await scheduler.schedule(priority) - the coroutine is resumed on a worker thread
+        auto schedule(Priority priority = Priority::normal) noexcept
+        {
+            struct ScheduleAwaiter
+            {
+                PriorityScheduler& scheduler;
+                Priority priority;
+
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                void await_suspend(std::coroutine_handle<> coro) const
+                {
+                    scheduler.post(coro, priority);
+                }
+
+                void await_resume() const noexcept
+                { }
+            };
+
+            return ScheduleAwaiter{*this, priority};
+        }
+
+        void post(std::coroutine_handle<> coro, Priority priority = Priority::normal)
+        {
+            {
+                std::lock_guard lk{mtx_};
+                auto& lane = lanes_[static_cast<std::size_t>(priority)];
+                lane.queue.push_back(Entry{coro, Clock::now()});
+                lane.stats.queue_depth = lane.queue.size();
+                lane.stats.max_queue_depth = std::max(lane.stats.max_queue_depth, lane.queue.size());
+            }
+            cv_.notify_one();
+        }
+
+        LaneStats stats(Priority priority) const
+        {
+            std::lock_guard lk{mtx_};
+            return lanes_[static_cast<std::size_t>(priority)].stats;
+        }
+
+        void reset_stats()
+        {
+            std::lock_guard lk{mtx_};
+            for (auto& lane : lanes_)
+                lane.stats = LaneStats{.queue_depth = lane.queue.size(), .max_queue_depth = lane.queue.size()};
+        }
+
+    private:
+        struct Entry
+        {
+            std::coroutine_handle<> coro;
+            Clock::time_point enqueued_at;
+        };
+
+        struct Lane
+        {
+            std::deque<Entry> queue;
+            LaneStats stats;
+        };
+
+        const StarvationLimits starvation_limits_;
+        mutable std::mutex mtx_;
+        std::condition_variable cv_;
+        std::array<Lane, priority_count> lanes_;
+        bool stop_ = false;
+        std::vector<std::jthread> threads_;
+
+        bool empty() const noexcept
+        {
+            return std::ranges::all_of(lanes_, [](const Lane& lane) { return lane.queue.empty(); });
+        }
+
+        // mtx_ has to be locked, at least one lane is not empty
+        std::coroutine_handle<> take()
+        {
+            const auto now = Clock::now();
+
+            auto highest = std::ranges::find_if(lanes_, [](const Lane& lane) { return !lane.queue.empty(); });
+            auto selected = highest;
+
+            // starvation protection - the most overdue handle of the lower lanes goes first
+            Clock::duration max_overdue{0};
+            for (auto lane = std::next(highest); lane != lanes_.end(); ++lane)
+            {
+                if (lane->queue.empty())
+                    continue;
+
+                const auto limit = starvation_limits_[static_cast<std::size_t>(lane - lanes_.begin())];
+                const auto waited = now - lane->queue.front().enqueued_at;
+                if (waited > limit && waited - limit > max_overdue)
+                {
+                    max_overdue = waited - limit;
+                    selected = lane;
+                }
+            }
+
+            const auto entry = selected->queue.front();
+            selected->queue.pop_front();
+
+            auto& stats = selected->stats;
+            const auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(now - entry.enqueued_at);
+            stats.queue_depth = selected->queue.size();
+            ++stats.resumed;
+            stats.total_wait += wait;
+            stats.max_wait = std::max(stats.max_wait, wait);
+            if (selected != highest)
+                ++stats.promoted;
+
+            return entry.coro;
+        }
+
+        void run()
+        {
+            while (true)
+            {
+                std::unique_lock lk{mtx_};
+                cv_.wait(lk, [this] { return stop_ || !empty(); });
+                if (empty())
+                    return;
+
+                auto coro = take();
+                lk.unlock();
+
+                coro.resume();
+            }
+        }
+    };
+} // namespace coro
+
+#endif
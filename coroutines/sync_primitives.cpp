@@ -0,0 +1,192 @@
+#include "detached_task.hpp"
+#include "sync_primitives.hpp"
+#include "work_stealing_scheduler.hpp"
+
+#include <atomic>
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <latch>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+coro::detached_task lock_and_log(coro::async_mutex& mutex, std::string name, std::vector<std::string>& log)
+{
+    auto guard = co_await mutex.scoped_lock();
+    log.push_back(name + " locked");
+}
+
+TEST_CASE("async_mutex - waiters suspend and get the lock in FIFO order")
+{
+    coro::async_mutex mutex;
+    std::vector<std::string> log;
+
+    REQUIRE(mutex.try_lock());
+
+    lock_and_log(mutex, "a", log);
+    lock_and_log(mutex, "b", log);
+    CHECK(log.empty());
+    CHECK_FALSE(mutex.try_lock());
+
+    mutex.unlock(); // hands the lock to a, a unlocks -> b
+    CHECK(log == std::vector<std::string>{"a locked", "b locked"});
+
+    CHECK(mutex.try_lock());
+    mutex.unlock();
+}
+
+coro::detached_task increment(coro::WorkStealingScheduler& pool, coro::async_mutex& mutex, long& counter, int count, std::latch& done)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (i % 16 == 0)
+            co_await pool.schedule();
+
+        co_await mutex.lock();
+        ++counter;
+        mutex.unlock();
+    }
+    done.count_down();
+}
+
+TEST_CASE("async_mutex - mutual exclusion on a thread pool")
+{
+    constexpr int task_count = 64;
+    constexpr int count = 1'000;
+
+    coro::async_mutex mutex;
+    long counter = 0;
+    std::latch done{task_count};
+    coro::WorkStealingScheduler pool{4};
+
+    for (int i = 0; i < task_count; ++i)
+        increment(pool, mutex, counter, count, done);
+    done.wait();
+
+    CHECK(counter == task_count * count);
+}
+
+coro::detached_task use_permit(coro::async_semaphore& semaphore, int id, std::vector<int>& holders)
+{
+    co_await semaphore.acquire();
+    holders.push_back(id);
+}
+
+TEST_CASE("async_semaphore - limits the number of holders")
+{
+    coro::async_semaphore semaphore{2};
+    std::vector<int> holders;
+
+    for (int id = 1; id <= 4; ++id)
+        use_permit(semaphore, id, holders);
+
+    CHECK(holders == std::vector{1, 2});
+    CHECK(semaphore.available() == 0);
+
+    semaphore.release(); // permit goes directly to the waiter
+    CHECK(holders == std::vector{1, 2, 3});
+
+    semaphore.release(3);
+    CHECK(holders == std::vector{1, 2, 3, 4});
+    CHECK(semaphore.available() == 2);
+    CHECK(semaphore.try_acquire());
+}
+
+coro::detached_task wait_for(coro::async_latch& latch, int id, std::vector<int>& resumed)
+{
+    co_await latch.wait();
+    resumed.push_back(id);
+}
+
+TEST_CASE("async_latch - waiters are resumed when the count reaches zero")
+{
+    coro::async_latch latch{2};
+    std::vector<int> resumed;
+
+    wait_for(latch, 1, resumed);
+    wait_for(latch, 2, resumed);
+
+    latch.count_down();
+    CHECK(resumed.empty());
+    CHECK_FALSE(latch.try_wait());
+
+    latch.count_down();
+    CHECK(resumed == std::vector{1, 2});
+
+    wait_for(latch, 3, resumed); // already released - doesn't suspend
+    CHECK(resumed == std::vector{1, 2, 3});
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark
+
+namespace
+{
+    struct SharedState
+    {
+        std::vector<long> values = std::vector<long>(16);
+
+        void update(int i)
+        {
+            for (auto& value : values)
+                value += i;
+        }
+    };
+} // namespace
+
+coro::detached_task update_with_async_mutex(coro::WorkStealingScheduler& pool, coro::async_mutex& mutex, SharedState& state, int count, std::latch& done)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (i % 8 == 0)
+            co_await pool.schedule();
+
+        auto guard = co_await mutex.scoped_lock();
+        state.update(i);
+    }
+    done.count_down();
+}
+
+coro::detached_task update_with_std_mutex(coro::WorkStealingScheduler& pool, std::mutex& mutex, SharedState& state, int count, std::latch& done)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        if (i % 8 == 0)
+            co_await pool.schedule();
+
+        std::lock_guard guard{mutex}; // blocks the worker thread
+        state.update(i);
+    }
+    done.count_down();
+}
+
+TEST_CASE("sync primitives benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+
+    constexpr int task_count = 256;
+    constexpr int count = 4'000;
+    const auto thread_count = std::max(std::thread::hardware_concurrency(), 2u);
+
+    coro::WorkStealingScheduler pool{thread_count};
+    SharedState state;
+
+    std::mutex std_mutex;
+    bm::run("contended std::mutex on a thread pool", task_count * count, [&] {
+        std::latch done{task_count};
+        for (int i = 0; i < task_count; ++i)
+            update_with_std_mutex(pool, std_mutex, state, count, done);
+        done.wait();
+    }, 5);
+
+    coro::async_mutex async_mutex;
+    bm::run("contended async_mutex on a thread pool", task_count * count, [&] {
+        std::latch done{task_count};
+        for (int i = 0; i < task_count; ++i)
+            update_with_async_mutex(pool, async_mutex, state, count, done);
+        done.wait();
+    }, 5);
+
+    bm::do_not_optimize(state.values);
+}
@@ -0,0 +1,377 @@
+#ifndef SYNC_PRIMITIVES_HPP
+#define SYNC_PRIMITIVES_HPP
+
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Synchronization primitives for coroutines - waiting suspends the coroutine, OS threads are never blocked.
+// Awaiters take std::coroutine_handle<> - any coroutine type can use them.
+
+namespace coro
+{
+    namespace detail
+    {
+        // Coroutines woken by unlock/release/count_down are resumed inline - unless the thread is already
+        // resuming a woken coroutine; then they are queued and resumed as soon as it suspends.
+        // Long unlock -> resume -> unlock chains don't grow the stack.
+        inline void resume_woken(std::coroutine_handle<> coro)
+        {
+            thread_local std::vector<std::coroutine_handle<>> queued;
+            thread_local bool resuming = false;
+
+            if (resuming)
+            {
+                queued.push_back(coro);
+                return;
+            }
+
+            resuming = true;
+            coro.resume();
+            for (std::size_t i = 0; i < queued.size(); ++i)
+                queued[i].resume();
+            queued.clear();
+            resuming = false;
+        }
+    } // namespace detail
+
+    class async_mutex;
+
+    // Unlocks the mutex when destroyed - co_await mutex.scoped_lock()
+    class async_lock_guard
+    {
+        async_mutex* mutex_;
+
+    public:
+        explicit async_lock_guard(async_mutex& mutex) noexcept
+            : mutex_{&mutex}
+        { }
+
+        async_lock_guard(async_lock_guard&& other) noexcept
+            : mutex_{std::exchange(other.mutex_, nullptr)}
+        { }
+
+        async_lock_guard(const async_lock_guard&) = delete;
+        async_lock_guard& operator=(const async_lock_guard&) = delete;
+        async_lock_guard& operator=(async_lock_guard&&) = delete;
+
+        inline ~async_lock_guard();
+    };
+
+    // Mutex with a lock-free list of waiters (the state word is "not locked", "locked" or the top of
+    // a stack of waiting awaiters). unlock() hands the ownership directly to the longest waiting coroutine.
+    class async_mutex
+    {
+        static constexpr std::uintptr_t not_locked = 1;
+        static constexpr std::uintptr_t locked_no_waiters = 0;
+
+    public:
+        class LockAwaiter
+        {
+            friend async_mutex;
+
+        protected:
+            async_mutex& mutex_;
+
+        private:
+            std::coroutine_handle<> coro_;
+            LockAwaiter* next_ = nullptr;
+
+        public:
+            explicit LockAwaiter(async_mutex& mutex) noexcept
+                : mutex_{mutex}
+            { }
+
+            bool await_ready() noexcept
+            {
+                return mutex_.try_lock();
+            }
+
+            bool await_suspend(std::coroutine_handle<> coro) noexcept
+            {
+                coro_ = coro;
+
+                auto state = mutex_.state_.load(std::memory_order_acquire);
+                while (true)
+                {
+                    if (state == not_locked)
+                    {
+                        if (mutex_.state_.compare_exchange_weak(state, locked_no_waiters, std::memory_order_acquire, std::memory_order_relaxed))
+                            return false; // unlocked in the meantime - continue without suspension
+                    }
+                    else
+                    {
+                        next_ = reinterpret_cast<LockAwaiter*>(state);
+                        if (mutex_.state_.compare_exchange_weak(state, reinterpret_cast<std::uintptr_t>(this), std::memory_order_release, std::memory_order_relaxed))
+                            return true;
+                    }
+                }
+            }
+
+            void await_resume() const noexcept
+            { }
+        };
+
+        class ScopedLockAwaiter : public LockAwaiter
+        {
+        public:
+            using LockAwaiter::LockAwaiter;
+
+            [[nodiscard]] async_lock_guard await_resume() const noexcept
+            {
+                return async_lock_guard{mutex_};
+            }
+        };
+
+        async_mutex() = default;
+        async_mutex(const async_mutex&) = delete;
+        async_mutex& operator=(const async_mutex&) = delete;
+
+        bool try_lock() noexcept
+        {
+            auto state = not_locked;
+            return state_.compare_exchange_strong(state, locked_no_waiters, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
+        // co_await mutex.lock() - mutex.unlock() has to be called
+        LockAwaiter lock() noexcept
+        {
+            return LockAwaiter{*this};
+        }
+
+        // auto guard = co_await mutex.scoped_lock();
+        ScopedLockAwaiter scoped_lock() noexcept
+        {
+            return ScopedLockAwaiter{*this};
+        }
+
+        void unlock()
+        {
+            auto* next = waiters_;
+
+            if (!next)
+            {
+                auto state = locked_no_waiters;
+                if (state_.compare_exchange_strong(state, not_locked, std::memory_order_release, std::memory_order_relaxed))
+                    return;
+
+                // take all newly pushed waiters - reversed into FIFO order
+                state = state_.exchange(locked_no_waiters, std::memory_order_acquire);
+                auto* waiter = reinterpret_cast<LockAwaiter*>(state);
+                do
+                {
+                    auto* older = waiter->next_;
+                    waiter->next_ = next;
+                    next = waiter;
+                    waiter = older;
+                } while (waiter);
+            }
+
+            waiters_ = next->next_;
+            detail::resume_woken(next->coro_); // the mutex stays locked - owned by the resumed coroutine
+        }
+
+    private:
+        std::atomic<std::uintptr_t> state_{not_locked};
+        LockAwaiter* waiters_ = nullptr; // FIFO of waiters taken from state_ - accessed only by the owner
+    };
+
+    async_lock_guard::~async_lock_guard()
+    {
+        if (mutex_)
+            mutex_->unlock();
+    }
+
+    // Counting semaphore - co_await semaphore.acquire() suspends while no permits are available.
+    // A released permit is handed directly to the longest waiting coroutine.
+    class async_semaphore
+    {
+        struct Waiter
+        {
+            std::coroutine_handle<> coro;
+            Waiter* next = nullptr;
+        };
+
+    public:
+        class AcquireAwaiter : Waiter
+        {
+            async_semaphore& semaphore_;
+
+        public:
+            explicit AcquireAwaiter(async_semaphore& semaphore) noexcept
+                : semaphore_{semaphore}
+            { }
+
+            bool await_ready() noexcept
+            {
+                return semaphore_.try_acquire();
+            }
+
+            bool await_suspend(std::coroutine_handle<> coro)
+            {
+                this->coro = coro;
+
+                std::lock_guard lk{semaphore_.waiters_mtx_};
+                if (semaphore_.try_acquire())
+                    return false;
+
+                (semaphore_.tail_ ? semaphore_.tail_->next : semaphore_.head_) = this;
+                semaphore_.tail_ = this;
+                return true;
+            }
+
+            void await_resume() const noexcept
+            { }
+        };
+
+        explicit async_semaphore(std::ptrdiff_t initial_count) noexcept
+            : count_{initial_count}
+        { }
+
+        async_semaphore(const async_semaphore&) = delete;
+        async_semaphore& operator=(const async_semaphore&) = delete;
+
+        bool try_acquire() noexcept
+        {
+            auto count = count_.load(std::memory_order_relaxed);
+            while (count > 0)
+                if (count_.compare_exchange_weak(count, count - 1, std::memory_order_acquire, std::memory_order_relaxed))
+                    return true;
+            return false;
+        }
+
+        AcquireAwaiter acquire() noexcept
+        {
+            return AcquireAwaiter{*this};
+        }
+
+        void release(std::ptrdiff_t update = 1)
+        {
+            Waiter* ready = nullptr;
+            {
+                std::lock_guard lk{waiters_mtx_};
+
+                Waiter** last = &ready;
+                for (; update > 0 && head_; --update)
+                {
+                    *last = std::exchange(head_, head_->next);
+                    last = &(*last)->next;
+                }
+                *last = nullptr;
+                if (!head_)
+                    tail_ = nullptr;
+
+                if (update > 0)
+                    count_.fetch_add(update, std::memory_order_release);
+            }
+
+            while (ready)
+                detail::resume_woken(std::exchange(ready, ready->next)->coro);
+        }
+
+        std::ptrdiff_t available() const noexcept
+        {
+            return count_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<std::ptrdiff_t> count_;
+        std::mutex waiters_mtx_; // locked only when a coroutine has to suspend or a permit is released
+        Waiter* head_ = nullptr;
+        Waiter* tail_ = nullptr;
+    };
+
+    // Single-use barrier - co_await latch.wait() suspends until count_down() reaches zero.
+    // Waiters are pushed to a lock-free stack.
+    class async_latch
+    {
+        static constexpr std::uintptr_t released = 1;
+
+    public:
+        class WaitAwaiter
+        {
+            friend async_latch;
+
+            async_latch& latch_;
+            std::coroutine_handle<> coro_;
+            WaitAwaiter* next_ = nullptr;
+
+        public:
+            explicit WaitAwaiter(async_latch& latch) noexcept
+                : latch_{latch}
+            { }
+
+            bool await_ready() const noexcept
+            {
+                return latch_.try_wait();
+            }
+
+            bool await_suspend(std::coroutine_handle<> coro) noexcept
+            {
+                coro_ = coro;
+
+                auto state = latch_.waiters_.load(std::memory_order_acquire);
+                do
+                {
+                    if (state == released)
+                        return false;
+                    next_ = reinterpret_cast<WaitAwaiter*>(state);
+                } while (!latch_.waiters_.compare_exchange_weak(state, reinterpret_cast<std::uintptr_t>(this), std::memory_order_acq_rel, std::memory_order_acquire));
+
+                return true;
+            }
+
+            void await_resume() const noexcept
+            { }
+        };
+
+        explicit async_latch(std::ptrdiff_t count) noexcept
+            : count_{count}
+            , waiters_{count > 0 ? 0 : released}
+        { }
+
+        async_latch(const async_latch&) = delete;
+        async_latch& operator=(const async_latch&) = delete;
+
+        void count_down(std::ptrdiff_t update = 1)
+        {
+            if (count_.fetch_sub(update, std::memory_order_acq_rel) != update)
+                return;
+
+            auto state = waiters_.exchange(released, std::memory_order_acq_rel);
+
+            WaitAwaiter* fifo = nullptr; // resumed in the order of arrival
+            auto* waiter = reinterpret_cast<WaitAwaiter*>(state);
+            while (waiter)
+            {
+                auto* older = waiter->next_;
+                waiter->next_ = fifo;
+                fifo = waiter;
+                waiter = older;
+            }
+
+            while (fifo)
+                detail::resume_woken(std::exchange(fifo, fifo->next_)->coro_);
+        }
+
+        bool try_wait() const noexcept
+        {
+            return count_.load(std::memory_order_acquire) <= 0;
+        }
+
+        WaitAwaiter wait() noexcept
+        {
+            return WaitAwaiter{*this};
+        }
+
+    private:
+        std::atomic<std::ptrdiff_t> count_;
+        std::atomic<std::uintptr_t> waiters_;
+    };
+} // namespace coro
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef TASK_RESUMER_HPP
+#define TASK_RESUMER_HPP
+
+#include "coro_trace.hpp"
+#include "frame_allocator.hpp"
+
+#include <coroutine>
+#include <exception>
+
+// Lazy coroutine resumed step by step by its owner
+class TaskResumer
+{
+public:
+    struct promise_type;
+    using CoroHandle = std::coroutine_handle<promise_type>;
+
+    struct promise_type : coro::PooledFramePromise
+    {
+        auto initial_suspend()
+        {
+            CORO_TRACE(create, CoroHandle::from_promise(*this).address());
+            return std::suspend_always{};
+        }
+
+        auto final_suspend() noexcept
+        {
+            CORO_TRACE(suspend, CoroHandle::from_promise(*this).address());
+            return std::suspend_always{};
+        }
+
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+
+        TaskResumer get_return_object()
+        {
+            return CoroHandle::from_promise(*this);
+        }
+
+        void return_void()
+        {}
+    };
+
+    TaskResumer(CoroHandle coro_hndl)
+        : coro_hndl_{coro_hndl}
+    { }
+
+    TaskResumer(const TaskResumer&) = delete;
+    TaskResumer& operator=(const TaskResumer&) = delete;
+
+    ~TaskResumer()
+    {
+        if (coro_hndl_)
+        {
+            CORO_TRACE(destroy, coro_hndl_.address());
+            coro_hndl_.destroy();
+        }
+    }
+
+    bool resume() const
+    {
+        if (!coro_hndl_ || coro_hndl_.done())
+            return false;
+
+        CORO_TRACE(resume, coro_hndl_.address());
+        coro_hndl_.resume();
+
+        if (coro_hndl_.done())
+            return false;
+
+        CORO_TRACE(suspend, coro_hndl_.address());
+        return true;
+    }
+
+private:
+    CoroHandle coro_hndl_;
+};
+
+#endif
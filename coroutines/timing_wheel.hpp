@@ -0,0 +1,212 @@
+#ifndef TIMING_WHEEL_HPP
+#define TIMING_WHEEL_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace coro::detail
+{
+    // Timer linked into a TimingWheel - the wheel doesn't own timers
+    struct TimerNode
+    {
+        std::uint64_t expiry = 0;
+        TimerNode* prev = nullptr;
+        TimerNode* next = nullptr;
+    };
+
+    // Hierarchical timing wheel (11 levels of 64 slots) over 64-bit ticks:
+    //  - O(1) insert and remove, a timer is moved to a lower level at most once per level
+    //  - timers expiring at the same tick are popped in insertion order
+    // A timer lives on the level of the highest bit in which its expiry differs from the wheel time.
+    class TimingWheel
+    {
+    public:
+        TimingWheel() = default;
+        TimingWheel(const TimingWheel&) = delete;
+        TimingWheel& operator=(const TimingWheel&) = delete;
+
+        // No timer in the wheel expires before this tick
+        std::uint64_t time() const noexcept
+        {
+            return time_;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        bool empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        // Expiries in the past are moved to time()
+        void insert(TimerNode* timer) noexcept
+        {
+            if (timer->expiry < time_)
+                timer->expiry = time_;
+
+            ++size_;
+            link(timer);
+        }
+
+        void remove(TimerNode* timer) noexcept
+        {
+            --size_;
+            unlink(timer);
+        }
+
+        // Tick at which the next timer may expire (exact for the earliest timers within 64 ticks) -
+        // max() when the wheel is empty
+        std::uint64_t next_expiry() const noexcept
+        {
+            if (!ready_.empty())
+                return time_;
+
+            const auto level = lowest_occupied_level();
+            return level == level_count ? std::numeric_limits<std::uint64_t>::max() : slot_start(level);
+        }
+
+        // Removes the earliest timer if it expires before or at the limit - nullptr otherwise
+        TimerNode* pop(std::uint64_t limit) noexcept
+        {
+            while (ready_.empty())
+            {
+                // timers on lower levels always expire before timers on higher levels
+                const auto level = lowest_occupied_level();
+                if (level == level_count)
+                    return nullptr;
+
+                const auto start = slot_start(level);
+                if (start > limit)
+                    return nullptr;
+
+                auto& slot = levels_[level].slots[static_cast<std::size_t>(std::countr_zero(levels_[level].occupied))];
+                levels_[level].occupied &= levels_[level].occupied - 1;
+                time_ = start;
+
+                // cascade - the timers are distributed to lower levels (or become ready)
+                auto* timer = slot.head;
+                slot = List{};
+                while (timer)
+                    link(std::exchange(timer, timer->next));
+            }
+
+            if (ready_.head->expiry > limit)
+                return nullptr;
+
+            --size_;
+            auto* timer = ready_.head;
+            ready_.erase(timer);
+            return timer;
+        }
+
+    private:
+        static constexpr int slot_bits = 6;
+        static constexpr std::size_t slot_count = 1 << slot_bits;
+        static constexpr std::size_t level_count = (64 + slot_bits - 1) / slot_bits;
+
+        struct List
+        {
+            TimerNode* head = nullptr;
+            TimerNode* tail = nullptr;
+
+            bool empty() const noexcept
+            {
+                return head == nullptr;
+            }
+
+            void push(TimerNode* timer) noexcept
+            {
+                timer->prev = tail;
+                timer->next = nullptr;
+                (tail ? tail->next : head) = timer;
+                tail = timer;
+            }
+
+            void erase(TimerNode* timer) noexcept
+            {
+                (timer->prev ? timer->prev->next : head) = timer->next;
+                (timer->next ? timer->next->prev : tail) = timer->prev;
+            }
+        };
+
+        struct Level
+        {
+            std::uint64_t occupied = 0; // bit per non-empty slot
+            std::array<List, slot_count> slots;
+        };
+
+        std::uint64_t time_ = 0; // <= expiry of every timer in the wheel
+        std::size_t size_ = 0;
+        List ready_;             // timers that expire at time_
+        std::array<Level, level_count> levels_;
+
+        std::size_t lowest_occupied_level() const noexcept
+        {
+            auto level = std::size_t{0};
+            while (level < level_count && levels_[level].occupied == 0)
+                ++level;
+            return level;
+        }
+
+        // Tick of the first occupied slot of the level
+        std::uint64_t slot_start(std::size_t level) const noexcept
+        {
+            const auto slot = static_cast<std::uint64_t>(std::countr_zero(levels_[level].occupied));
+            const auto shift = level * slot_bits;
+            const auto higher_bits_mask = shift + slot_bits >= 64 ? 0 : ~std::uint64_t{0} << (shift + slot_bits);
+            return (time_ & higher_bits_mask) | (slot << shift);
+        }
+
+        struct Position
+        {
+            std::size_t level;
+            std::size_t slot;
+        };
+
+        // The position of a timer is determined by its expiry and the wheel time - cascading keeps
+        // this invariant, so a timer can be removed without storing its position
+        Position position_of(const TimerNode* timer) const noexcept
+        {
+            const auto diff = timer->expiry ^ time_;
+            const auto level = static_cast<std::size_t>(63 - std::countl_zero(diff)) / slot_bits;
+            return Position{level, static_cast<std::size_t>(timer->expiry >> (level * slot_bits)) & (slot_count - 1)};
+        }
+
+        void link(TimerNode* timer) noexcept
+        {
+            if (timer->expiry == time_)
+            {
+                ready_.push(timer);
+                return;
+            }
+
+            const auto [level, slot] = position_of(timer);
+            levels_[level].slots[slot].push(timer);
+            levels_[level].occupied |= std::uint64_t{1} << slot;
+        }
+
+        void unlink(TimerNode* timer) noexcept
+        {
+            if (timer->expiry == time_)
+            {
+                ready_.erase(timer);
+                return;
+            }
+
+            const auto [level, slot] = position_of(timer);
+            auto& list = levels_[level].slots[slot];
+            list.erase(timer);
+            if (list.empty())
+                levels_[level].occupied &= ~(std::uint64_t{1} << slot);
+        }
+    };
+} // namespace coro::detail
+
+#endif
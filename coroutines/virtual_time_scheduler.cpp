@@ -0,0 +1,196 @@
+#include "detached_task.hpp"
+#include "virtual_time_scheduler.hpp"
+
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+struct Event
+{
+    std::string name;
+    std::int64_t time_ms;
+
+    bool operator==(const Event&) const = default;
+};
+
+coro::detached_task ticker(coro::VirtualTimeScheduler& scheduler, std::string name, std::chrono::milliseconds period, int count, std::vector<Event>& events)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        co_await scheduler.delay(period);
+        events.push_back({name, std::chrono::duration_cast<std::chrono::milliseconds>(scheduler.now().time_since_epoch()).count()});
+    }
+}
+
+TEST_CASE("virtual time scheduler - coroutines wake up in virtual time order")
+{
+    coro::VirtualTimeScheduler scheduler;
+    std::vector<Event> events;
+
+    ticker(scheduler, "slow", 300ms, 2, events);
+    ticker(scheduler, "fast", 100ms, 4, events);
+    ticker(scheduler, "hourly", 1h, 1, events);
+    CHECK(scheduler.pending() == 3);
+
+    const auto start = std::chrono::steady_clock::now();
+    scheduler.run();
+    CHECK(std::chrono::steady_clock::now() - start < 1s); // no real waiting
+
+    // same wake-up time - in the order of delay() calls
+    CHECK(events == std::vector<Event>{
+        {"fast", 100}, {"fast", 200}, {"slow", 300}, {"fast", 300}, {"fast", 400}, {"slow", 600}, {"hourly", 3'600'000}});
+    CHECK(scheduler.pending() == 0);
+    CHECK(scheduler.now().time_since_epoch() == 1h);
+}
+
+TEST_CASE("virtual time scheduler - run for a period of time")
+{
+    coro::VirtualTimeScheduler scheduler;
+    std::vector<Event> events;
+
+    ticker(scheduler, "tick", 40ms, 10, events);
+
+    scheduler.run_for(100ms);
+    CHECK(events.size() == 2);
+    CHECK(scheduler.now().time_since_epoch() == 100ms);
+
+    scheduler.run_for(20ms); // 120 ms
+    CHECK(events.size() == 3);
+
+    scheduler.run();
+    CHECK(events.size() == 10);
+    CHECK(events.back() == Event{"tick", 400});
+}
+
+coro::detached_task random_walker(coro::VirtualTimeScheduler& scheduler, int id, std::uint64_t seed, int steps, std::vector<int>& trace)
+{
+    for (int i = 0; i < steps; ++i)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        co_await scheduler.delay(std::chrono::microseconds{(seed >> 33) % 10'000});
+        trace.push_back(id);
+    }
+}
+
+TEST_CASE("virtual time scheduler - runs are reproducible")
+{
+    auto simulate = [] {
+        coro::VirtualTimeScheduler scheduler;
+        std::vector<int> trace;
+        for (int id = 0; id < 100; ++id)
+            random_walker(scheduler, id, id, 50, trace);
+        scheduler.run();
+        return trace;
+    };
+
+    const auto trace = simulate();
+    CHECK(trace.size() == 100 * 50);
+    CHECK(simulate() == trace);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark
+
+// Baseline - timers in a binary heap ordered by (expiry, sequence number)
+class HeapScheduler
+{
+public:
+    using duration = std::chrono::nanoseconds;
+
+    auto delay(duration time)
+    {
+        struct DelayAwaiter
+        {
+            HeapScheduler& scheduler;
+            std::uint64_t expiry;
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> coro)
+            {
+                scheduler.timers_.push(Timer{expiry, scheduler.sequence_++, coro});
+            }
+
+            void await_resume() const noexcept
+            { }
+        };
+
+        return DelayAwaiter{*this, now_ + static_cast<std::uint64_t>(time.count())};
+    }
+
+    void run()
+    {
+        while (!timers_.empty())
+        {
+            auto timer = timers_.top();
+            timers_.pop();
+            now_ = timer.expiry;
+            timer.coro.resume();
+        }
+    }
+
+private:
+    struct Timer
+    {
+        std::uint64_t expiry;
+        std::uint64_t sequence;
+        std::coroutine_handle<> coro;
+
+        bool operator>(const Timer& other) const noexcept
+        {
+            return expiry != other.expiry ? expiry > other.expiry : sequence > other.sequence;
+        }
+    };
+
+    std::uint64_t now_ = 0;
+    std::uint64_t sequence_ = 0;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers_;
+};
+
+template <typename Scheduler>
+coro::detached_task simulated_client(Scheduler& scheduler, std::uint64_t seed, int requests, long& completed)
+{
+    for (int i = 0; i < requests; ++i)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        co_await scheduler.delay(std::chrono::microseconds{100 + (seed >> 33) % 100'000}); // think time
+        ++completed;
+    }
+}
+
+TEST_CASE("virtual time scheduler benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+
+    constexpr int client_count = 1'000'000;
+    constexpr int requests = 4;
+
+    auto simulate = [](auto& scheduler) {
+        long completed = 0;
+        for (int i = 0; i < client_count; ++i)
+            simulated_client(scheduler, i, requests, completed);
+        scheduler.run();
+        bm::do_not_optimize(completed);
+    };
+
+    bm::run("binary heap - 10^6 coroutines", client_count * requests, [&] {
+        HeapScheduler scheduler;
+        simulate(scheduler);
+    }, 3);
+
+    bm::run("timing wheel - 10^6 coroutines", client_count * requests, [&] {
+        coro::VirtualTimeScheduler scheduler;
+        simulate(scheduler);
+    }, 3);
+}
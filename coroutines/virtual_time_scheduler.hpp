@@ -0,0 +1,119 @@
+#ifndef VIRTUAL_TIME_SCHEDULER_HPP
+#define VIRTUAL_TIME_SCHEDULER_HPP
+
+#include "timing_wheel.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace coro
+{
+    // Discrete-event simulation scheduler - co_await scheduler.delay(10ms) suspends the coroutine
+    // for 10 ms of virtual time. run() resumes coroutines in the order of their virtual wake-up times
+    // as fast as possible; the virtual clock jumps directly to the next event.
+    //  - timers are kept in a hierarchical timing wheel (detail::TimingWheel) - O(1) insertion
+    //  - awaiters are linked into the wheel - no allocations per delay
+    //  - single-threaded and deterministic: the same program resumes coroutines in the same order
+    //    (coroutines waking up at the same time are resumed in the order they called delay())
+    class VirtualTimeScheduler
+    {
+    public:
+        using duration = std::chrono::nanoseconds;
+        using time_point = std::chrono::time_point<VirtualTimeScheduler, duration>;
+
+        class DelayAwaiter : detail::TimerNode
+        {
+            friend VirtualTimeScheduler;
+
+            VirtualTimeScheduler& scheduler_;
+            std::coroutine_handle<> coro_;
+
+        public:
+            DelayAwaiter(VirtualTimeScheduler& scheduler, std::uint64_t expiry) noexcept
+                : detail::TimerNode{expiry}
+                , scheduler_{scheduler}
+            { }
+
+            bool await_ready() const noexcept
+            {
+                return false; // delay(0) lets other coroutines scheduled for now run first
+            }
+
+            void await_suspend(std::coroutine_handle<> coro) noexcept
+            {
+                coro_ = coro;
+                scheduler_.wheel_.insert(this);
+            }
+
+            void await_resume() const noexcept
+            { }
+        };
+
+        VirtualTimeScheduler() = default;
+        VirtualTimeScheduler(const VirtualTimeScheduler&) = delete;
+        VirtualTimeScheduler& operator=(const VirtualTimeScheduler&) = delete;
+
+        time_point now() const noexcept
+        {
+            return time_point{duration{now_}};
+        }
+
+        DelayAwaiter delay(duration time) noexcept
+        {
+            return DelayAwaiter{*this, now_ + static_cast<std::uint64_t>(std::max(time.count(), duration::rep{0}))};
+        }
+
+        DelayAwaiter delay_until(time_point time) noexcept
+        {
+            return DelayAwaiter{*this, std::max(now_, static_cast<std::uint64_t>(std::max(time.time_since_epoch().count(), duration::rep{0})))};
+        }
+
+        std::size_t pending() const noexcept
+        {
+            return wheel_.size();
+        }
+
+        // Resumes coroutines until there are no pending delays
+        void run()
+        {
+            while (resume_next(std::numeric_limits<std::uint64_t>::max()))
+            { }
+        }
+
+        // Resumes coroutines waking up before or at the given time - the clock is then set to that time
+        void run_until(time_point time)
+        {
+            const auto limit = static_cast<std::uint64_t>(time.time_since_epoch().count());
+            while (resume_next(limit))
+            { }
+            now_ = std::max(now_, limit);
+        }
+
+        void run_for(duration time)
+        {
+            run_until(now() + time);
+        }
+
+    private:
+        std::uint64_t now_ = 0; // virtual time reported to coroutines
+        detail::TimingWheel wheel_;
+
+        // Resumes one coroutine waking up before or at the limit - false if there is none
+        bool resume_next(std::uint64_t limit)
+        {
+            auto* awaiter = static_cast<DelayAwaiter*>(wheel_.pop(limit));
+            if (!awaiter)
+                return false;
+
+            now_ = awaiter->expiry;
+            awaiter->coro_.resume();
+            return true;
+        }
+    };
+} // namespace coro
+
+#endif
@@ -0,0 +1,216 @@
+#include "detached_task.hpp"
+#include "work_stealing_scheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <condition_variable>
+#include <deque>
+#include <latch>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Chase-Lev deque")
+{
+    coro::ChaseLevDeque<int> deque{2};
+
+    SECTION("owner pops in LIFO order, thieves steal in FIFO order")
+    {
+        for (int i = 1; i <= 5; ++i) // grows the buffer
+            deque.push(i);
+
+        CHECK(deque.size() == 5);
+        CHECK(deque.pop() == 5);
+        CHECK(deque.steal() == 1);
+        CHECK(deque.pop() == 4);
+        CHECK(deque.steal() == 2);
+        CHECK(deque.pop() == 3);
+        CHECK(deque.pop() == std::nullopt);
+        CHECK(deque.steal() == std::nullopt);
+    }
+
+    SECTION("every item is taken exactly once under concurrent stealing")
+    {
+        constexpr int count = 100'000;
+        std::atomic<bool> done{false};
+        std::vector<std::vector<int>> stolen(3);
+        std::vector<int> popped;
+
+        {
+            std::vector<std::jthread> thieves;
+            for (auto& items : stolen)
+                thieves.emplace_back([&] {
+                    while (!done.load() || deque.size() > 0)
+                        if (auto item = deque.steal())
+                            items.push_back(*item);
+                });
+
+            for (int i = 0; i < count; ++i)
+            {
+                deque.push(i);
+                if (i % 3 == 0)
+                    if (auto item = deque.pop())
+                        popped.push_back(*item);
+            }
+
+            while (auto item = deque.pop())
+                popped.push_back(*item);
+
+            done = true;
+        }
+
+        std::vector<int> all = popped;
+        for (const auto& items : stolen)
+            all.insert(all.end(), items.begin(), items.end());
+        std::ranges::sort(all);
+
+        REQUIRE(all.size() == count);
+        CHECK(std::ranges::adjacent_find(all) == all.end());
+    }
+}
+
+coro::detached_task hop_to_pool(coro::WorkStealingScheduler& scheduler, std::thread::id& resumed_on, std::latch& done)
+{
+    co_await scheduler.schedule();
+    resumed_on = std::this_thread::get_id();
+    done.count_down();
+}
+
+template <typename Scheduler>
+coro::detached_task leaf_task(Scheduler& scheduler, std::atomic<int>& remaining, std::latch& done)
+{
+    co_await scheduler.schedule();
+
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        done.count_down();
+}
+
+// fan-out from a worker thread - children land in the worker's deque and are stolen by the others
+template <typename Scheduler>
+coro::detached_task fan_out(Scheduler& scheduler, int count, std::atomic<int>& remaining, std::latch& done)
+{
+    co_await scheduler.schedule();
+
+    for (int i = 0; i < count; ++i)
+        leaf_task(scheduler, remaining, done);
+}
+
+TEST_CASE("work-stealing scheduler")
+{
+    coro::WorkStealingScheduler scheduler{4};
+
+    SECTION("co_await schedule() resumes coroutine on a worker thread")
+    {
+        std::thread::id resumed_on;
+        std::latch done{1};
+
+        hop_to_pool(scheduler, resumed_on, done);
+        done.wait();
+
+        CHECK(resumed_on != std::this_thread::get_id());
+    }
+
+    SECTION("fan-out/fan-in")
+    {
+        constexpr int count = 10'000;
+        std::atomic<int> remaining{count};
+        std::latch done{1};
+
+        fan_out(scheduler, count, remaining, done);
+        done.wait();
+
+        CHECK(remaining == 0);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////
+// Benchmark
+
+// Baseline - all workers share one mutex protected queue
+class SharedQueueScheduler
+{
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::coroutine_handle<>> queue_;
+    bool stop_ = false;
+    std::vector<std::jthread> threads_;
+
+public:
+    explicit SharedQueueScheduler(std::size_t thread_count)
+    {
+        for (std::size_t i = 0; i < thread_count; ++i)
+            threads_.emplace_back([this] {
+                while (true)
+                {
+                    std::unique_lock lk{mtx_};
+                    cv_.wait(lk, [this] { return stop_ || !queue_.empty(); });
+                    if (queue_.empty())
+                        return;
+                    auto coro = queue_.front();
+                    queue_.pop_front();
+                    lk.unlock();
+                    coro.resume();
+                }
+            });
+    }
+
+    ~SharedQueueScheduler()
+    {
+        {
+            std::lock_guard lk{mtx_};
+            stop_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    auto schedule() noexcept
+    {
+        struct ScheduleAwaiter
+        {
+            SharedQueueScheduler& scheduler;
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> coro) const
+            {
+                {
+                    std::lock_guard lk{scheduler.mtx_};
+                    scheduler.queue_.push_back(coro);
+                }
+                scheduler.cv_.notify_one();
+            }
+
+            void await_resume() const noexcept
+            { }
+        };
+
+        return ScheduleAwaiter{*this};
+    }
+};
+
+TEST_CASE("work-stealing scheduler benchmark", "[.benchmark]")
+{
+    namespace bm = helpers::benchmark;
+
+    constexpr int count = 1'000'000;
+    const auto thread_count = std::max(std::thread::hardware_concurrency(), 2u);
+
+    auto fan_out_fan_in = [&](auto& scheduler) {
+        std::atomic<int> remaining{count};
+        std::latch done{1};
+        fan_out(scheduler, count, remaining, done);
+        done.wait();
+    };
+
+    SharedQueueScheduler shared_queue{thread_count};
+    bm::run("fan-out/fan-in - shared queue", count, [&] { fan_out_fan_in(shared_queue); }, 5);
+
+    coro::WorkStealingScheduler work_stealing{thread_count};
+    bm::run("fan-out/fan-in - work stealing", count, [&] { fan_out_fan_in(work_stealing); }, 5);
+}
@@ -0,0 +1,356 @@
+#ifndef WORK_STEALING_SCHEDULER_HPP
+#define WORK_STEALING_SCHEDULER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace coro
+{
+    inline constexpr std::size_t cache_line_size = 64;
+
+    // Chase-Lev work-stealing deque (Le, Pop, Cohen, Zappa Nardelli - "Correct and Efficient
+    // Work-Stealing for Weak Memory Models").
+    //  - push/pop at the bottom - owner thread only (LIFO)
+    //  - steal from the top - any thread (FIFO)
+    // The buffer grows on demand; retired buffers are kept alive until the deque is destroyed
+    // because a concurrent thief may still read from them.
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    class ChaseLevDeque
+    {
+        struct Buffer
+        {
+            std::int64_t capacity;
+            std::unique_ptr<std::atomic<T>[]> items;
+
+            explicit Buffer(std::int64_t capacity)
+                : capacity{capacity}
+                , items{std::make_unique<std::atomic<T>[]>(capacity)}
+            { }
+
+            T get(std::int64_t i) const noexcept
+            {
+                return items[i & (capacity - 1)].load(std::memory_order_relaxed);
+            }
+
+            void put(std::int64_t i, T item) noexcept
+            {
+                items[i & (capacity - 1)].store(item, std::memory_order_relaxed);
+            }
+        };
+
+        alignas(cache_line_size) std::atomic<std::int64_t> top_{0};
+        alignas(cache_line_size) std::atomic<std::int64_t> bottom_{0};
+        std::atomic<Buffer*> buffer_;
+        std::vector<std::unique_ptr<Buffer>> buffers_; // owner only
+
+        Buffer* grow(Buffer* old, std::int64_t top, std::int64_t bottom)
+        {
+            auto& bigger = buffers_.emplace_back(std::make_unique<Buffer>(old->capacity * 2));
+            for (auto i = top; i < bottom; ++i)
+                bigger->put(i, old->get(i));
+            buffer_.store(bigger.get(), std::memory_order_release);
+            return bigger.get();
+        }
+
+    public:
+        explicit ChaseLevDeque(std::size_t capacity = 1024)
+        {
+            buffers_.push_back(std::make_unique<Buffer>(static_cast<std::int64_t>(std::bit_ceil(capacity))));
+            buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+        }
+
+        ChaseLevDeque(const ChaseLevDeque&) = delete;
+        ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+        void push(T item)
+        {
+            const auto bottom = bottom_.load(std::memory_order_relaxed);
+            const auto top = top_.load(std::memory_order_acquire);
+            auto* buffer = buffer_.load(std::memory_order_relaxed);
+
+            if (bottom - top > buffer->capacity - 1)
+                buffer = grow(buffer, top, bottom);
+
+            buffer->put(bottom, item);
+            bottom_.store(bottom + 1, std::memory_order_release);
+        }
+
+        std::optional<T> pop() noexcept
+        {
+            const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            auto* buffer = buffer_.load(std::memory_order_relaxed);
+            bottom_.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto top = top_.load(std::memory_order_relaxed);
+
+            if (top > bottom) // empty
+            {
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            T item = buffer->get(bottom);
+
+            if (top == bottom) // last item - race with thieves
+            {
+                const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                if (!won)
+                    return std::nullopt;
+            }
+
+            return item;
+        }
+
+        std::optional<T> steal() noexcept
+        {
+            auto top = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto bottom = bottom_.load(std::memory_order_acquire);
+
+            if (top >= bottom)
+                return std::nullopt;
+
+            auto* buffer = buffer_.load(std::memory_order_acquire);
+            T item = buffer->get(top);
+
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return std::nullopt; // lost the race with another thief or the owner
+
+            return item;
+        }
+
+        std::size_t size() const noexcept
+        {
+            const auto bottom = bottom_.load(std::memory_order_relaxed);
+            const auto top = top_.load(std::memory_order_relaxed);
+            return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+        }
+    };
+
+    class WorkStealingScheduler;
+
+    namespace detail
+    {
+        struct CurrentWorker
+        {
+            const WorkStealingScheduler* scheduler = nullptr;
+            std::size_t index = 0;
+        };
+
+        inline thread_local CurrentWorker current_worker;
+    } // namespace detail
+
+    // Thread pool resuming coroutine handles.
+    // Every worker owns a Chase-Lev deque: handles posted by a worker go to its own deque,
+    // idle workers steal from randomly chosen victims. Handles posted from other threads
+    // are placed in a shared injection queue.
+    class WorkStealingScheduler
+    {
+    public:
+        explicit WorkStealingScheduler(std::size_t thread_count = std::thread::hardware_concurrency())
+            : workers_(std::max<std::size_t>(thread_count, 1))
+        {
+            threads_.reserve(workers_.size());
+            for (std::size_t i = 0; i < workers_.size(); ++i)
+                threads_.emplace_back([this, i] { run(i); });
+        }
+
+        WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+        WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+        // Handles that were not resumed before destruction are not destroyed
+        ~WorkStealingScheduler()
+        {
+            stop_.store(true);
+            epoch_.fetch_add(1);
+            epoch_.notify_all();
+            threads_.clear();
+        }
+
+        std::size_t thread_count() const noexcept
+        {
+            return workers_.size();
+        }
+
+        // co_await scheduler.schedule() - the coroutine is resumed on a worker thread
+        auto schedule() noexcept
+        {
+            struct ScheduleAwaiter
+            {
+                WorkStealingScheduler& scheduler;
+
+                bool await_ready() const noexcept
+                {
+                    return false;
+                }
+
+                void await_suspend(std::coroutine_handle<> coro) const
+                {
+                    scheduler.post(coro);
+                }
+
+                void await_resume() const noexcept
+                { }
+            };
+
+            return ScheduleAwaiter{*this};
+        }
+
+        void post(std::coroutine_handle<> coro)
+        {
+            if (detail::current_worker.scheduler == this)
+                workers_[detail::current_worker.index].deque.push(coro);
+            else
+            {
+                std::lock_guard lk{injection_mtx_};
+                injection_queue_.push_back(coro);
+                injected_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            wake_one();
+        }
+
+        // true if the calling thread is a worker of this scheduler
+        bool on_worker_thread() const noexcept
+        {
+            return detail::current_worker.scheduler == this;
+        }
+
+    private:
+        static constexpr int spin_count = 64;
+
+        struct alignas(cache_line_size) Worker
+        {
+            ChaseLevDeque<std::coroutine_handle<>> deque;
+        };
+
+        std::vector<Worker> workers_;
+        std::mutex injection_mtx_;
+        std::deque<std::coroutine_handle<>> injection_queue_;
+        std::atomic<std::size_t> injected_{0};
+        std::atomic<std::uint32_t> epoch_{0};
+        std::atomic<std::uint32_t> searching_{0};
+        std::atomic<std::uint32_t> sleeping_{0};
+        std::atomic<bool> stop_{false};
+        std::vector<std::jthread> threads_;
+
+        // Wakes a sleeping worker unless some worker is already searching for work
+        void wake_one()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (searching_.load(std::memory_order_relaxed) == 0 && sleeping_.load(std::memory_order_relaxed) > 0)
+            {
+                epoch_.fetch_add(1, std::memory_order_release);
+                epoch_.notify_one();
+            }
+        }
+
+        std::coroutine_handle<> take_injected()
+        {
+            if (injected_.load(std::memory_order_relaxed) == 0)
+                return {};
+
+            std::lock_guard lk{injection_mtx_};
+            if (injection_queue_.empty())
+                return {};
+
+            auto coro = injection_queue_.front();
+            injection_queue_.pop_front();
+            injected_.fetch_sub(1, std::memory_order_relaxed);
+            return coro;
+        }
+
+        std::coroutine_handle<> find_work(std::size_t index, std::uint64_t& rng_state)
+        {
+            if (auto coro = workers_[index].deque.pop())
+                return *coro;
+
+            if (auto coro = take_injected())
+                return coro;
+
+            // xorshift - random first victim, then round robin
+            rng_state ^= rng_state << 13;
+            rng_state ^= rng_state >> 7;
+            rng_state ^= rng_state << 17;
+
+            const auto count = workers_.size();
+            const auto first_victim = static_cast<std::size_t>(rng_state % count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto victim = (first_victim + i) % count;
+                if (victim == index)
+                    continue;
+                if (auto coro = workers_[victim].deque.steal())
+                    return *coro;
+            }
+
+            return {};
+        }
+
+        // Looks for work in other queues - spins for a while, then goes to sleep.
+        // Returns an empty handle when woken up without work.
+        std::coroutine_handle<> search(std::size_t index, std::uint64_t& rng_state)
+        {
+            searching_.fetch_add(1);
+
+            for (int i = 0; i < spin_count; ++i)
+            {
+                if (auto coro = find_work(index, rng_state))
+                {
+                    if (searching_.fetch_sub(1) == 1)
+                        wake_one(); // the last searcher found work - there may be more of it
+                    return coro;
+                }
+            }
+
+            searching_.fetch_sub(1);
+
+            sleeping_.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const auto epoch = epoch_.load(std::memory_order_acquire);
+
+            auto coro = find_work(index, rng_state);
+            if (!coro && !stop_.load())
+                epoch_.wait(epoch);
+
+            sleeping_.fetch_sub(1);
+            return coro;
+        }
+
+        void run(std::size_t index)
+        {
+            detail::current_worker = detail::CurrentWorker{this, index};
+            std::uint64_t rng_state = 0x9E3779B97F4A7C15ull * (index + 1);
+
+            while (true)
+            {
+                std::coroutine_handle<> coro;
+
+                if (auto local = workers_[index].deque.pop())
+                    coro = *local;
+                else
+                    coro = search(index, rng_state);
+
+                if (coro)
+                    coro.resume();
+                else if (stop_.load())
+                    return;
+            }
+        }
+    };
+} // namespace coro
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace helpers::benchmark
+{
+    template <typename T>
+    void do_not_optimize(const T& value)
+    {
+#if defined(__GNUC__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+    // Counts user-space instructions retired by the calling thread (Linux perf events).
+    // available() is false when perf events are not supported or not permitted.
+    class InstructionCounter
+    {
+        int fd_ = -1;
+
+    public:
+        InstructionCounter()
+        {
+#if defined(__linux__)
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+
+            fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+        }
+
+        InstructionCounter(const InstructionCounter&) = delete;
+        InstructionCounter& operator=(const InstructionCounter&) = delete;
+
+        ~InstructionCounter()
+        {
+#if defined(__linux__)
+            if (fd_ >= 0)
+                close(fd_);
+#endif
+        }
+
+        bool available() const noexcept
+        {
+            return fd_ >= 0;
+        }
+
+        void start() noexcept
+        {
+#if defined(__linux__)
+            if (fd_ >= 0)
+            {
+                ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+            }
+#endif
+        }
+
+        std::optional<std::uint64_t> stop() noexcept
+        {
+#if defined(__linux__)
+            if (fd_ >= 0)
+            {
+                ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+
+                std::uint64_t count = 0;
+                if (read(fd_, &count, sizeof(count)) == sizeof(count))
+                    return count;
+            }
+#endif
+            return std::nullopt;
+        }
+    };
+
+    // Number of OS threads of the process (0 if /proc is not available)
+    inline std::size_t os_thread_count()
+    {
+        std::ifstream status{"/proc/self/status"};
+        for (std::string line; std::getline(status, line);)
+            if (line.starts_with("Threads:"))
+                return std::stoul(line.substr(8));
+        return 0;
+    }
+
+    struct Result
+    {
+        std::string name;
+        double ns_per_op;
+        std::optional<double> instructions_per_op;
+        std::optional<double> allocations_per_op = std::nullopt; // filled in by benchmarks counting allocations
+    };
+
+    inline std::ostream& operator<<(std::ostream& out, const Result& result)
+    {
+        out << std::left << std::setw(48) << result.name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << result.ns_per_op << " ns/op";
+
+        if (result.instructions_per_op)
+            out << std::setw(10) << *result.instructions_per_op << " instructions/op";
+
+        if (result.allocations_per_op)
+            out << std::setw(10) << *result.allocations_per_op << " allocations/op";
+
+        return out;
+    }
+
+    // Calls `fn` (which performs `ops_per_run` operations) several times after a warm-up
+    // and reports the best observed time and instruction count per operation
+    template <std::invocable F>
+    Result measure(std::string name, std::size_t ops_per_run, F&& fn, std::size_t runs = 10)
+    {
+        fn(); // warm-up
+
+        InstructionCounter counter;
+        double best_ns = std::numeric_limits<double>::max();
+        std::optional<std::uint64_t> best_instructions;
+
+        for (std::size_t i = 0; i < runs; ++i)
+        {
+            counter.start();
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            const auto instructions = counter.stop();
+
+            best_ns = std::min(best_ns, std::chrono::duration<double, std::nano>(elapsed).count());
+            if (instructions)
+                best_instructions = std::min(*instructions, best_instructions.value_or(*instructions));
+        }
+
+        Result result{std::move(name), best_ns / ops_per_run, std::nullopt};
+        if (best_instructions)
+            result.instructions_per_op = static_cast<double>(*best_instructions) / ops_per_run;
+
+        return result;
+    }
+
+    template <std::invocable F>
+    Result run(std::string name, std::size_t ops_per_run, F&& fn, std::size_t runs = 10)
+    {
+        auto result = measure(std::move(name), ops_per_run, std::forward<F>(fn), runs);
+        std::cout << result << "\n";
+        return result;
+    }
+} // namespace helpers::benchmark
+
+#endif
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <utility>
 #include <cstdint>
+#include <vector>
 
 namespace helpers
 {
@@ -61,6 +62,18 @@ namespace helpers
 
         return result_data;
     }
+
+    // Runtime-sized variant for datasets too large for std::array (and the stack)
+    [[nodiscard]] inline std::vector<int> create_numeric_dataset(std::size_t size, uint32_t seed = 42, int low = -100, int high = 100)
+    {
+        std::vector<int> data(size);
+
+        std::mt19937 mt_rnd{seed};
+        const uint32_t width = high - low;
+        std::ranges::generate(data, [&] { return static_cast<int>(mt_rnd() % width) + low; });
+
+        return data;
+    }
 } // namespace helpers
 
 #endif
\ No newline at end of file
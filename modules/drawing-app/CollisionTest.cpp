@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+import Shapes;
+
+namespace
+{
+    std::vector<Shapes::BoundingBox> random_boxes(std::size_t count, std::uint32_t seed)
+    {
+        std::mt19937 rng{seed};
+        std::uniform_int_distribution<int> position{-20'000, 20'000};
+        std::uniform_int_distribution<int> extent{1, 100};
+
+        std::vector<Shapes::BoundingBox> boxes(count);
+        for (auto& box : boxes)
+        {
+            box.left = position(rng);
+            box.top = position(rng);
+            box.right = box.left + extent(rng);
+            box.bottom = box.top + extent(rng);
+        }
+        return boxes;
+    }
+
+    std::vector<Shapes::OverlapPair> brute_force_overlaps(const std::vector<Shapes::BoundingBox>& boxes)
+    {
+        std::vector<Shapes::OverlapPair> pairs;
+        for (std::uint32_t i = 0; i < boxes.size(); ++i)
+            for (std::uint32_t j = i + 1; j < boxes.size(); ++j)
+                if (boxes[i].overlaps(boxes[j]))
+                    pairs.push_back(Shapes::OverlapPair{i, j});
+        return pairs;
+    }
+
+    std::vector<Shapes::OverlapPair> sorted(std::vector<Shapes::OverlapPair> pairs)
+    {
+        std::ranges::sort(pairs, {}, [](const Shapes::OverlapPair& pair) { return std::pair{pair.first, pair.second}; });
+        return pairs;
+    }
+} // namespace
+
+TEST_CASE("broad phase - finds the same pairs as a brute force check")
+{
+    Shapes::BroadPhase broad_phase{4};
+    std::vector<Shapes::OverlapPair> pairs;
+
+    // sizes below and above the per-thread threshold - the instance (and its workers) is reused
+    for (std::size_t count : {0, 1, 2, 500, 20'000, 9'000, 20'000, 3'000})
+    {
+        const auto boxes = random_boxes(count, static_cast<std::uint32_t>(count));
+        broad_phase.find_overlaps(boxes, pairs);
+
+        INFO("boxes: " << count);
+        CHECK(sorted(pairs) == brute_force_overlaps(boxes));
+    }
+}
+
+TEST_CASE("broad phase - edge cases")
+{
+    Shapes::BroadPhase broad_phase{2};
+    std::vector<Shapes::OverlapPair> pairs{{7, 8}}; // replaced
+
+    SECTION("touching boxes don't overlap")
+    {
+        const Shapes::BoundingBox boxes[] = {{0, 0, 10, 10}, {10, 0, 20, 10}, {0, 10, 10, 20}};
+        broad_phase.find_overlaps(boxes, pairs);
+
+        CHECK(pairs.empty());
+    }
+
+    SECTION("identical and nested boxes")
+    {
+        const Shapes::BoundingBox boxes[] = {{-5, -5, 5, 5}, {-1, -1, 1, 1}, {-5, -5, 5, 5}};
+        broad_phase.find_overlaps(boxes, pairs);
+
+        CHECK(sorted(pairs) == std::vector<Shapes::OverlapPair>{{0, 1}, {0, 2}, {1, 2}});
+    }
+}
@@ -0,0 +1,350 @@
+module;
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+export module PersistentVector;
+
+// Immutable vector with structural sharing (bit-partitioned 32-way trie + tail).
+// Every "modifying" operation returns a new vector and shares all untouched nodes
+// with the original, so old versions stay valid and can be read from other threads
+// without synchronization. push_back, set, update and pop_back are O(log32 n);
+// erase is O((n - index) log32 n) - the trie has no slice/concat (RRB) support.
+export template <typename T>
+class PersistentVector
+{
+    static constexpr std::size_t bits = 5;
+    static constexpr std::size_t width = 1 << bits;
+    static constexpr std::size_t mask = width - 1;
+
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node
+    {
+        std::vector<NodePtr> children; // branch
+        std::vector<T> values;         // leaf
+    };
+
+    std::size_t size_ = 0;
+    std::size_t shift_ = bits;
+    NodePtr root_ = std::make_shared<const Node>();
+    NodePtr tail_ = std::make_shared<const Node>();
+
+    PersistentVector(std::size_t size, std::size_t shift, NodePtr root, NodePtr tail)
+        : size_{size}
+        , shift_{shift}
+        , root_{std::move(root)}
+        , tail_{std::move(tail)}
+    { }
+
+    std::size_t tail_offset() const noexcept
+    {
+        return size_ < width ? 0 : ((size_ - 1) >> bits) << bits;
+    }
+
+    const Node* leaf_for(std::size_t index) const noexcept
+    {
+        if (index >= tail_offset())
+            return tail_.get();
+
+        const Node* node = root_.get();
+        for (std::size_t level = shift_; level > 0; level -= bits)
+            node = node->children[(index >> level) & mask].get();
+
+        return node;
+    }
+
+    NodePtr leaf_ptr_for(std::size_t index) const
+    {
+        NodePtr node = root_;
+        for (std::size_t level = shift_; level > 0; level -= bits)
+            node = node->children[(index >> level) & mask];
+
+        return node;
+    }
+
+    static NodePtr new_path(std::size_t level, NodePtr node)
+    {
+        if (level == 0)
+            return node;
+
+        auto branch = std::make_shared<Node>();
+        branch->children.reserve(width);
+        branch->children.push_back(new_path(level - bits, std::move(node)));
+        return branch;
+    }
+
+    NodePtr push_tail(std::size_t level, const Node& parent, NodePtr tail) const
+    {
+        auto result = std::make_shared<Node>(parent);
+        const std::size_t sub_index = ((size_ - 1) >> level) & mask;
+
+        NodePtr inserted;
+        if (level == bits)
+            inserted = std::move(tail);
+        else if (sub_index < parent.children.size())
+            inserted = push_tail(level - bits, *parent.children[sub_index], std::move(tail));
+        else
+            inserted = new_path(level - bits, std::move(tail));
+
+        if (sub_index < result->children.size())
+            result->children[sub_index] = std::move(inserted);
+        else
+            result->children.push_back(std::move(inserted));
+
+        return result;
+    }
+
+    NodePtr pop_tail(std::size_t level, const Node& node) const
+    {
+        const std::size_t sub_index = ((size_ - 2) >> level) & mask;
+
+        if (level > bits)
+        {
+            NodePtr new_child = pop_tail(level - bits, *node.children[sub_index]);
+            if (!new_child && sub_index == 0)
+                return nullptr;
+
+            auto result = std::make_shared<Node>(node);
+            if (new_child)
+                result->children[sub_index] = std::move(new_child);
+            else
+                result->children.resize(sub_index);
+            return result;
+        }
+
+        if (sub_index == 0)
+            return nullptr;
+
+        auto result = std::make_shared<Node>(node);
+        result->children.resize(sub_index);
+        return result;
+    }
+
+    template <typename U>
+    static NodePtr do_set(std::size_t level, const Node& node, std::size_t index, U&& value)
+    {
+        auto result = std::make_shared<Node>(node);
+
+        if (level == 0)
+            result->values[index & mask] = std::forward<U>(value);
+        else
+        {
+            const std::size_t sub_index = (index >> level) & mask;
+            result->children[sub_index] = do_set(level - bits, *node.children[sub_index], index, std::forward<U>(value));
+        }
+
+        return result;
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using const_reference = const T&;
+
+    class const_iterator
+    {
+        const PersistentVector* vec_ = nullptr;
+        std::size_t index_ = 0;
+        const Node* leaf_ = nullptr;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        const_iterator(const PersistentVector* vec, std::size_t index)
+            : vec_{vec}
+            , index_{index}
+            , leaf_{index < vec->size() ? vec->leaf_for(index) : nullptr}
+        { }
+
+        reference operator*() const
+        {
+            return leaf_->values[index_ & mask];
+        }
+
+        pointer operator->() const
+        {
+            return &**this;
+        }
+
+        const_iterator& operator++()
+        {
+            ++index_;
+            if ((index_ & mask) == 0)
+                leaf_ = index_ < vec_->size() ? vec_->leaf_for(index_) : nullptr;
+            return *this;
+        }
+
+        const_iterator operator++(int)
+        {
+            auto tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const const_iterator& other) const noexcept
+        {
+            return index_ == other.index_;
+        }
+    };
+
+    PersistentVector() = default;
+
+    size_type size() const noexcept
+    {
+        return size_;
+    }
+
+    bool empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    const T& operator[](size_type index) const
+    {
+        return leaf_for(index)->values[index & mask];
+    }
+
+    const T& at(size_type index) const
+    {
+        if (index >= size_)
+            throw std::out_of_range("PersistentVector::at");
+
+        return (*this)[index];
+    }
+
+    const T& front() const
+    {
+        return (*this)[0];
+    }
+
+    const T& back() const
+    {
+        return (*this)[size_ - 1];
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator{this, 0};
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator{this, size_};
+    }
+
+    template <typename U>
+    [[nodiscard]] PersistentVector push_back(U&& value) const
+    {
+        if (size_ - tail_offset() < width)
+        {
+            auto new_tail = std::make_shared<Node>(*tail_);
+            new_tail->values.reserve(width);
+            new_tail->values.push_back(std::forward<U>(value));
+            return PersistentVector{size_ + 1, shift_, root_, std::move(new_tail)};
+        }
+
+        NodePtr new_root;
+        std::size_t new_shift = shift_;
+
+        if ((size_ >> bits) > (std::size_t{1} << shift_)) // root overflow
+        {
+            auto branch = std::make_shared<Node>();
+            branch->children.reserve(width);
+            branch->children.push_back(root_);
+            branch->children.push_back(new_path(shift_, tail_));
+            new_root = std::move(branch);
+            new_shift += bits;
+        }
+        else
+            new_root = push_tail(shift_, *root_, tail_);
+
+        auto new_tail = std::make_shared<Node>();
+        new_tail->values.reserve(width);
+        new_tail->values.push_back(std::forward<U>(value));
+
+        return PersistentVector{size_ + 1, new_shift, std::move(new_root), std::move(new_tail)};
+    }
+
+    template <typename U>
+    [[nodiscard]] PersistentVector set(size_type index, U&& value) const
+    {
+        if (index >= size_)
+            throw std::out_of_range("PersistentVector::set");
+
+        if (index >= tail_offset())
+        {
+            auto new_tail = std::make_shared<Node>(*tail_);
+            new_tail->values[index & mask] = std::forward<U>(value);
+            return PersistentVector{size_, shift_, root_, std::move(new_tail)};
+        }
+
+        return PersistentVector{size_, shift_, do_set(shift_, *root_, index, std::forward<U>(value)), tail_};
+    }
+
+    template <typename F>
+    [[nodiscard]] PersistentVector update(size_type index, F&& func) const
+    {
+        T value = at(index);
+        std::forward<F>(func)(value);
+        return set(index, std::move(value));
+    }
+
+    [[nodiscard]] PersistentVector pop_back() const
+    {
+        if (size_ == 0)
+            throw std::out_of_range("PersistentVector::pop_back");
+
+        if (size_ == 1)
+            return PersistentVector{};
+
+        if (size_ - tail_offset() > 1)
+        {
+            auto new_tail = std::make_shared<Node>(*tail_);
+            new_tail->values.pop_back();
+            return PersistentVector{size_ - 1, shift_, root_, std::move(new_tail)};
+        }
+
+        NodePtr new_tail = leaf_ptr_for(size_ - 2);
+
+        NodePtr new_root = pop_tail(shift_, *root_);
+        std::size_t new_shift = shift_;
+
+        if (!new_root)
+            new_root = std::make_shared<const Node>();
+        if (new_shift > bits && new_root->children.size() == 1)
+        {
+            new_root = new_root->children[0];
+            new_shift -= bits;
+        }
+
+        return PersistentVector{size_ - 1, new_shift, std::move(new_root), std::move(new_tail)};
+    }
+
+    // O(n - index): elements after the erased one are re-appended
+    [[nodiscard]] PersistentVector erase(size_type index) const
+    {
+        if (index >= size_)
+            throw std::out_of_range("PersistentVector::erase");
+
+        PersistentVector result = *this;
+        while (result.size() > index)
+            result = result.pop_back();
+
+        for (size_type i = index + 1; i < size_; ++i)
+            result = result.push_back((*this)[i]);
+
+        return result;
+    }
+};
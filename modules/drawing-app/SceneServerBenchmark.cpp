@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+import Shapes;
+
+// Loopback benchmark: a client sends batches of move commands to SceneServer
+// over a Unix domain socket and waits for the delta frame of each batch.
+
+int main(int argc, char** argv)
+{
+    const std::string socket_path = argc > 1 ? argv[1] : "/tmp/drawing_app_scene.sock";
+    constexpr std::uint32_t shape_count = 10'000;
+    constexpr int rounds = 2'000;
+
+    Shapes::ShapeFactory& shape_factory = Shapes::SingletonShapeFactory::instance();
+    shape_factory.register_creator(Shapes::Rectangle::id, [] { return std::make_unique<Shapes::Rectangle>(); });
+    shape_factory.register_creator(Shapes::Square::id, [] { return std::make_unique<Shapes::Square>(); });
+
+    Shapes::SceneServer server{shape_factory, socket_path};
+    server.start();
+
+    Shapes::SceneClient client{socket_path};
+
+    std::vector<Shapes::Command> batch;
+    for (std::uint32_t i = 0; i < shape_count; ++i)
+    {
+        const auto type = i % 2 ? Shapes::CommandType::create_rectangle : Shapes::CommandType::create_square;
+        batch.push_back(Shapes::Command{type, 0, static_cast<int>(i), 0, 10, 20});
+    }
+    client.apply(batch);
+
+    for (std::uint32_t batch_size : {1, 16, 256, 4096})
+    {
+        std::vector<double> latencies_us;
+        latencies_us.reserve(rounds);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < rounds; ++round)
+        {
+            batch.clear();
+            for (std::uint32_t i = 0; i < batch_size; ++i)
+                batch.push_back(Shapes::Command{Shapes::CommandType::move, (round * batch_size + i) % shape_count, 1, 1, 0, 0});
+
+            const auto sent = std::chrono::steady_clock::now();
+            client.apply(batch);
+            latencies_us.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sent).count());
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::ranges::sort(latencies_us);
+        std::cout << "batch size " << batch_size
+                  << ": " << rounds * batch_size / elapsed.count() << " commands/s"
+                  << ", latency p50 " << latencies_us[latencies_us.size() / 2] << " us"
+                  << ", p99 " << latencies_us[latencies_us.size() * 99 / 100] << " us\n";
+    }
+
+    server.stop();
+}
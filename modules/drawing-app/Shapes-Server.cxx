@@ -0,0 +1,459 @@
+module;
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+export module Shapes:Server;
+
+import :Base;
+import :Factory;
+import :Point;
+import :Rectangle;
+import :Square;
+
+export namespace Shapes
+{
+    enum class CommandType : std::uint32_t
+    {
+        create_rectangle,
+        create_square,
+        move,
+        resize
+    };
+
+    // Fixed-size binary command - host byte order, the protocol is meant for the local host only.
+    // Wire format of a batch: std::uint32_t count followed by `count` commands.
+    struct Command
+    {
+        CommandType type;
+        std::uint32_t shape_id; // ignored by create commands
+        std::int32_t x, y;      // create: position, move: offset
+        std::int32_t width, height;
+    };
+
+    // Entry of a delta frame: std::uint32_t count followed by `count` states
+    // (only the final state of each shape touched by a batch is sent)
+    struct ShapeState
+    {
+        std::uint32_t shape_id;
+        std::int32_t x, y;
+        std::int32_t width, height;
+
+        friend bool operator==(const ShapeState&, const ShapeState&) = default;
+    };
+
+    // Serves batched commands on a Unix domain socket; shapes are created with the ShapeFactory.
+    // Every batch is applied under a single lock acquisition and answered with a delta frame.
+    // A client sending a batch larger than max_batch_size is disconnected.
+    class SceneServer
+    {
+    public:
+        static constexpr std::uint32_t max_batch_size = 1 << 16;
+
+    private:
+        ShapeFactory& factory_;
+        std::string socket_path_;
+        int listen_fd_ = -1;
+
+        std::mutex shapes_mtx_;
+        std::vector<std::unique_ptr<Shape>> shapes_;
+
+        std::mutex clients_mtx_;
+        std::vector<int> client_fds_;
+        std::vector<std::jthread> client_threads_;   // running sessions
+        std::vector<std::jthread> finished_threads_; // joined by the next accept or stop()
+        std::jthread accept_thread_;
+
+        void accept_loop();
+        void serve(int client_fd);
+        void apply(std::span<const Command> batch, std::vector<ShapeState>& delta);
+
+    public:
+        SceneServer(ShapeFactory& factory, std::string socket_path);
+
+        SceneServer(const SceneServer&) = delete;
+        SceneServer& operator=(const SceneServer&) = delete;
+
+        ~SceneServer();
+
+        void start();
+        void stop();
+
+        std::size_t shape_count();
+
+        // number of connected clients
+        std::size_t client_count();
+    };
+
+    class SceneClient
+    {
+        int fd_ = -1;
+        std::vector<ShapeState> delta_;
+
+    public:
+        explicit SceneClient(const std::string& socket_path);
+
+        SceneClient(const SceneClient&) = delete;
+        SceneClient& operator=(const SceneClient&) = delete;
+
+        ~SceneClient();
+
+        void send(std::span<const Command> batch);
+
+        // valid until the next call
+        std::span<const ShapeState> receive_delta();
+
+        std::span<const ShapeState> apply(std::span<const Command> batch)
+        {
+            send(batch);
+            return receive_delta();
+        }
+    };
+} // namespace Shapes
+
+namespace
+{
+    [[noreturn]] void throw_errno(const char* what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // returns false on orderly shutdown of the peer before any byte was read
+    bool read_all(int fd, void* buffer, std::size_t size)
+    {
+        auto* ptr = static_cast<std::byte*>(buffer);
+        std::size_t done = 0;
+
+        while (done < size)
+        {
+            const ssize_t count = ::read(fd, ptr + done, size - done);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count < 0)
+                throw_errno("read");
+            if (count == 0)
+            {
+                if (done == 0)
+                    return false;
+                throw std::system_error(std::make_error_code(std::errc::connection_reset), "read");
+            }
+            done += count;
+        }
+
+        return true;
+    }
+
+    // MSG_NOSIGNAL - a client that has disconnected fails the write with EPIPE instead of raising SIGPIPE
+    void write_all(int fd, iovec* parts, int part_count)
+    {
+        while (part_count > 0)
+        {
+            msghdr msg{};
+            msg.msg_iov = parts;
+            msg.msg_iovlen = part_count;
+
+            ssize_t count = ::sendmsg(fd, &msg, MSG_NOSIGNAL);
+            if (count < 0 && errno == EINTR)
+                continue;
+            if (count < 0)
+                throw_errno("sendmsg");
+
+            while (part_count > 0 && static_cast<std::size_t>(count) >= parts->iov_len)
+            {
+                count -= parts->iov_len;
+                ++parts;
+                --part_count;
+            }
+            if (part_count > 0)
+            {
+                parts->iov_base = static_cast<std::byte*>(parts->iov_base) + count;
+                parts->iov_len -= count;
+            }
+        }
+    }
+
+    template <typename T>
+    void write_frame(int fd, std::span<const T> items)
+    {
+        auto count = static_cast<std::uint32_t>(items.size());
+        iovec parts[] = {{&count, sizeof(count)}, {const_cast<T*>(items.data()), items.size_bytes()}};
+        write_all(fd, parts, 2);
+    }
+
+    template <typename T>
+    bool read_frame(int fd, std::vector<T>& items, std::uint32_t max_count)
+    {
+        std::uint32_t count = 0;
+        if (!read_all(fd, &count, sizeof(count)))
+            return false;
+
+        if (count > max_count)
+            throw std::system_error(std::make_error_code(std::errc::message_size), "read");
+
+        items.resize(count);
+        if (count > 0 && !read_all(fd, items.data(), count * sizeof(T)))
+            throw std::system_error(std::make_error_code(std::errc::connection_reset), "read");
+
+        return true;
+    }
+
+    sockaddr_un make_address(const std::string& socket_path)
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socket_path.size() >= sizeof(address.sun_path))
+            throw std::system_error(std::make_error_code(std::errc::filename_too_long), socket_path);
+
+        std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+        return address;
+    }
+
+    Shapes::ShapeState state_of(std::uint32_t shape_id, const Shapes::Shape& shape)
+    {
+        if (auto* rect = dynamic_cast<const Shapes::Rectangle*>(&shape))
+            return {shape_id, rect->coord().x, rect->coord().y, rect->width(), rect->height()};
+
+        if (auto* square = dynamic_cast<const Shapes::Square*>(&shape))
+            return {shape_id, square->coord().x, square->coord().y, square->size(), square->size()};
+
+        return {shape_id, 0, 0, 0, 0};
+    }
+
+    void resize(Shapes::Shape& shape, int width, int height)
+    {
+        if (auto* rect = dynamic_cast<Shapes::Rectangle*>(&shape))
+        {
+            rect->set_width(width);
+            rect->set_height(height);
+        }
+        else if (auto* square = dynamic_cast<Shapes::Square*>(&shape))
+            square->set_size(width);
+    }
+} // namespace
+
+namespace Shapes
+{
+    SceneServer::SceneServer(ShapeFactory& factory, std::string socket_path)
+        : factory_{factory}
+        , socket_path_{std::move(socket_path)}
+    { }
+
+    SceneServer::~SceneServer()
+    {
+        stop();
+    }
+
+    void SceneServer::start()
+    {
+        const auto address = make_address(socket_path_);
+        ::unlink(socket_path_.c_str());
+
+        listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listen_fd_ < 0)
+            throw_errno("socket");
+
+        if (::bind(listen_fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0
+            || ::listen(listen_fd_, SOMAXCONN) < 0)
+        {
+            const int error = errno;
+            ::close(std::exchange(listen_fd_, -1));
+            throw std::system_error(error, std::generic_category(), "bind/listen");
+        }
+
+        accept_thread_ = std::jthread{[this] { accept_loop(); }};
+    }
+
+    void SceneServer::stop()
+    {
+        if (listen_fd_ < 0)
+            return;
+
+        ::shutdown(listen_fd_, SHUT_RDWR); // wakes up accept()
+        if (accept_thread_.joinable())
+            accept_thread_.join();
+
+        std::vector<std::jthread> client_threads;
+        std::vector<std::jthread> finished_threads;
+        {
+            std::lock_guard lk{clients_mtx_};
+            for (int fd : client_fds_)
+                ::shutdown(fd, SHUT_RDWR);
+            client_threads.swap(client_threads_);
+            finished_threads.swap(finished_threads_);
+        }
+        client_threads.clear(); // joins
+        finished_threads.clear();
+
+        ::close(std::exchange(listen_fd_, -1));
+        ::unlink(socket_path_.c_str());
+    }
+
+    std::size_t SceneServer::shape_count()
+    {
+        std::lock_guard lk{shapes_mtx_};
+        return shapes_.size();
+    }
+
+    std::size_t SceneServer::client_count()
+    {
+        std::lock_guard lk{clients_mtx_};
+        return client_threads_.size();
+    }
+
+    void SceneServer::accept_loop()
+    {
+        while (true)
+        {
+            const int client_fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client_fd < 0)
+            {
+                if (errno == EINTR || errno == ECONNABORTED)
+                    continue;
+                return; // listening socket was shut down
+            }
+
+            std::vector<std::jthread> finished_threads;
+            {
+                std::lock_guard lk{clients_mtx_};
+                client_fds_.push_back(client_fd);
+                client_threads_.emplace_back([this, client_fd] { serve(client_fd); });
+                finished_threads.swap(finished_threads_);
+            }
+            finished_threads.clear(); // joins - their sessions have returned from serve()
+        }
+    }
+
+    void SceneServer::serve(int client_fd)
+    {
+        std::vector<Command> batch;
+        std::vector<ShapeState> delta;
+
+        try
+        {
+            while (read_frame(client_fd, batch, max_batch_size))
+            {
+                apply(batch, delta);
+                write_frame(client_fd, std::span<const ShapeState>{delta});
+            }
+        }
+        catch (const std::exception&)
+        {
+            // broken connection or invalid batch - drop the client
+        }
+
+        std::lock_guard lk{clients_mtx_};
+        std::erase(client_fds_, client_fd);
+        ::close(client_fd);
+
+        // a thread can't join itself - its handle is joined by the next accept or stop()
+        // (unless stop() has taken it already)
+        const auto self = std::ranges::find(client_threads_, std::this_thread::get_id(), &std::jthread::get_id);
+        if (self != client_threads_.end())
+        {
+            finished_threads_.push_back(std::move(*self));
+            client_threads_.erase(self);
+        }
+    }
+
+    void SceneServer::apply(std::span<const Command> batch, std::vector<ShapeState>& delta)
+    {
+        std::vector<std::uint32_t> touched;
+        touched.reserve(batch.size());
+        delta.clear();
+
+        std::lock_guard lk{shapes_mtx_};
+
+        for (const auto& cmd : batch)
+        {
+            switch (cmd.type)
+            {
+            case CommandType::create_rectangle:
+            case CommandType::create_square:
+            {
+                const bool is_rect = cmd.type == CommandType::create_rectangle;
+                auto shape = factory_.create(is_rect ? Rectangle::id : Square::id);
+                resize(*shape, cmd.width, cmd.height);
+                shape->move(cmd.x, cmd.y);
+
+                touched.push_back(static_cast<std::uint32_t>(shapes_.size()));
+                shapes_.push_back(std::move(shape));
+                break;
+            }
+            case CommandType::move:
+                if (cmd.shape_id < shapes_.size())
+                {
+                    shapes_[cmd.shape_id]->move(cmd.x, cmd.y);
+                    touched.push_back(cmd.shape_id);
+                }
+                break;
+            case CommandType::resize:
+                if (cmd.shape_id < shapes_.size())
+                {
+                    resize(*shapes_[cmd.shape_id], cmd.width, cmd.height);
+                    touched.push_back(cmd.shape_id);
+                }
+                break;
+            }
+        }
+
+        std::ranges::sort(touched);
+        const auto [first, last] = std::ranges::unique(touched);
+        touched.erase(first, last);
+
+        for (auto shape_id : touched)
+            delta.push_back(state_of(shape_id, *shapes_[shape_id]));
+    }
+
+    SceneClient::SceneClient(const std::string& socket_path)
+    {
+        const auto address = make_address(socket_path);
+
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd_ < 0)
+            throw_errno("socket");
+
+        if (::connect(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+        {
+            const int error = errno;
+            ::close(std::exchange(fd_, -1));
+            throw std::system_error(error, std::generic_category(), "connect");
+        }
+    }
+
+    SceneClient::~SceneClient()
+    {
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+
+    void SceneClient::send(std::span<const Command> batch)
+    {
+        write_frame(fd_, batch);
+    }
+
+    std::span<const ShapeState> SceneClient::receive_delta()
+    {
+        if (!read_frame(fd_, delta_, std::numeric_limits<std::uint32_t>::max()))
+            throw std::system_error(std::make_error_code(std::errc::connection_reset), "receive_delta");
+
+        return delta_;
+    }
+} // namespace Shapes
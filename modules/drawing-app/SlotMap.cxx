@@ -0,0 +1,214 @@
+module;
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+export module SlotMap;
+
+// 64-bit handle: slot index + generation of the slot at the time of insertion
+export struct SlotMapHandle
+{
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0; // 0 is never used by a live element - default handle is null
+
+    bool operator==(const SlotMapHandle&) const = default;
+};
+
+// Generational slot map: O(1) insert/erase/lookup, values stored contiguously
+// (erase moves the last value into the hole), stale handles are detected
+// because erasing bumps the generation of the slot.
+export template <typename T>
+class SlotMap
+{
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    struct Slot
+    {
+        std::uint32_t position; // index in values_ or next free slot
+        std::uint32_t generation;
+    };
+
+    std::vector<Slot> slots_;
+    std::vector<T> values_;
+    std::vector<std::uint32_t> owners_; // slot index for each value
+    std::uint32_t free_head_ = npos;
+
+    bool is_live(const SlotMapHandle& handle) const noexcept
+    {
+        if (handle.index >= slots_.size())
+            return false;
+
+        const auto& slot = slots_[handle.index];
+        return slot.generation == handle.generation && slot.position < owners_.size() && owners_[slot.position] == handle.index;
+    }
+
+    // geometric growth - push_back is guaranteed not to reallocate afterwards
+    template <typename U>
+    static void reserve_for_one_more(std::vector<U>& vec)
+    {
+        if (vec.size() == vec.capacity())
+            vec.reserve(std::max<std::size_t>(8, vec.capacity() * 2));
+    }
+
+public:
+    using value_type = T;
+    using handle = SlotMapHandle;
+    using iterator = typename std::vector<T>::iterator;
+    using const_iterator = typename std::vector<T>::const_iterator;
+
+    // Strong exception guarantee: capacity is reserved first and the value is constructed
+    // before a free slot is taken - nothing after the construction can throw
+    template <typename... TArgs>
+    handle emplace(TArgs&&... args)
+    {
+        if (free_head_ == npos)
+            reserve_for_one_more(slots_);
+        reserve_for_one_more(owners_);
+
+        values_.emplace_back(std::forward<TArgs>(args)...);
+
+        std::uint32_t index;
+        if (free_head_ != npos)
+        {
+            index = free_head_;
+            free_head_ = slots_[index].position;
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(Slot{npos, 1});
+        }
+
+        owners_.push_back(index);
+        slots_[index].position = static_cast<std::uint32_t>(values_.size() - 1);
+
+        return handle{index, slots_[index].generation};
+    }
+
+    handle insert(T value)
+    {
+        return emplace(std::move(value));
+    }
+
+    bool erase(const handle& h)
+    {
+        if (!is_live(h))
+            return false;
+
+        auto& slot = slots_[h.index];
+        const std::uint32_t position = slot.position;
+
+        if (position != values_.size() - 1)
+        {
+            values_[position] = std::move(values_.back());
+            owners_[position] = owners_.back();
+            slots_[owners_[position]].position = position;
+        }
+        values_.pop_back();
+        owners_.pop_back();
+
+        if (++slot.generation == 0)
+            slot.generation = 1;
+        slot.position = free_head_;
+        free_head_ = h.index;
+
+        return true;
+    }
+
+    bool contains(const handle& h) const noexcept
+    {
+        return is_live(h);
+    }
+
+    T* find(const handle& h) noexcept
+    {
+        return is_live(h) ? &values_[slots_[h.index].position] : nullptr;
+    }
+
+    const T* find(const handle& h) const noexcept
+    {
+        return is_live(h) ? &values_[slots_[h.index].position] : nullptr;
+    }
+
+    T& at(const handle& h)
+    {
+        if (!is_live(h))
+            throw std::out_of_range("SlotMap::at - stale or invalid handle");
+
+        return values_[slots_[h.index].position];
+    }
+
+    const T& at(const handle& h) const
+    {
+        if (!is_live(h))
+            throw std::out_of_range("SlotMap::at - stale or invalid handle");
+
+        return values_[slots_[h.index].position];
+    }
+
+    // handle of the value at given position in dense storage
+    handle handle_at(std::size_t position) const
+    {
+        const std::uint32_t index = owners_.at(position);
+        return handle{index, slots_[index].generation};
+    }
+
+    std::size_t size() const noexcept
+    {
+        return values_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return values_.empty();
+    }
+
+    void clear()
+    {
+        while (!values_.empty())
+            erase(handle_at(values_.size() - 1));
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        slots_.reserve(capacity);
+        values_.reserve(capacity);
+        owners_.reserve(capacity);
+    }
+
+    std::span<T> values() noexcept
+    {
+        return values_;
+    }
+
+    std::span<const T> values() const noexcept
+    {
+        return values_;
+    }
+
+    iterator begin() noexcept
+    {
+        return values_.begin();
+    }
+
+    iterator end() noexcept
+    {
+        return values_.end();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return values_.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return values_.end();
+    }
+};
@@ -15,4 +15,53 @@ int main()
     sq.draw();
     sq.move(50, 20);
     sq.draw();
+
+    Shapes::SceneStore scene_store;
+    scene_store.edit([](const Shapes::Scene& scene) {
+        return scene.add(Shapes::Rectangle{10, 20, 100, 50}).add(Shapes::Square{0, 0, 30});
+    });
+
+    auto snapshot = scene_store.snapshot(); // pinned version - not affected by later edits
+    scene_store.edit([](const Shapes::Scene& scene) { return scene.move(1, 5, 5); });
+
+    snapshot->draw();
+    scene_store.snapshot()->draw();
+
+    std::stringstream scene_file;
+    for (int i = 0; i < 10'000; ++i)
+    {
+        if (i % 2)
+            scene_file << "Rectangle [" << i << ",0] 100 50\n";
+        else
+            scene_file << "Square [" << i << ",0] 30\n";
+    }
+
+    Shapes::GeometryPool geometry_pool;
+    auto flyweights = Shapes::load_shapes(scene_file, geometry_pool);
+    flyweights.front().draw();
+
+    const double bytes_before = sizeof(std::unique_ptr<Shapes::Shape>) + (sizeof(Shapes::Rectangle) + sizeof(Shapes::Square)) / 2.0;
+    const double bytes_after = sizeof(Shapes::FlyweightShape) + static_cast<double>(geometry_pool.memory_usage()) / flyweights.size();
+    std::cout << "Memory per shape: unique_ptr<Shape> " << bytes_before << " B + heap block overhead"
+              << ", flyweight " << bytes_after << " B (" << geometry_pool.size() << " unique geometries)\n";
+
+    std::vector<Shapes::BoundingBox> boxes;
+    for (const auto& shape : flyweights)
+        boxes.push_back(Shapes::bounding_box(shape));
+
+    Shapes::BroadPhase broad_phase;
+    std::vector<Shapes::OverlapPair> overlaps; // reused between frames
+    broad_phase.find_overlaps(boxes, overlaps);
+    std::cout << "Overlapping pairs: " << overlaps.size() << "\n";
+
+    Shapes::ShapeRegistry registry;
+    auto rect_handle = registry.insert(Shapes::Rectangle{10, 10, 40, 20});
+    auto square_handle = registry.insert(Shapes::Square{100, 100, 15});
+
+    registry.erase(rect_handle);
+    Shapes::move_all(registry, 1, 1); // iterates contiguous storage
+    Shapes::draw_all(registry);
+
+    std::cout << "rect_handle is " << (registry.contains(rect_handle) ? "valid" : "stale")
+              << ", square_handle is " << (registry.contains(square_handle) ? "valid" : "stale") << "\n";
 }
\ No newline at end of file
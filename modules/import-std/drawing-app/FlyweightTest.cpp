@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import Shapes;
+
+namespace
+{
+    template <typename Shape>
+    std::string drawn(const Shape& shape)
+    {
+        std::ostringstream out;
+        auto* const previous = std::cout.rdbuf(out.rdbuf());
+        shape.draw();
+        std::cout.rdbuf(previous);
+        return out.str();
+    }
+} // namespace
+
+TEST_CASE("geometry pool - equal geometries are interned once")
+{
+    Shapes::GeometryPool pool;
+
+    const auto& rect = pool.intern({Shapes::ShapeKind::rectangle, 10, 20});
+    const auto& same_rect = pool.intern({Shapes::ShapeKind::rectangle, 10, 20});
+    const auto& square = pool.intern({Shapes::ShapeKind::square, 10, 10});
+    const auto& rect_10x10 = pool.intern({Shapes::ShapeKind::rectangle, 10, 10});
+
+    CHECK(&rect == &same_rect);
+    CHECK(&square != &rect_10x10); // same size, different kind
+    CHECK(pool.size() == 3);
+}
+
+TEST_CASE("load_shapes - shares geometry between shapes")
+{
+    std::istringstream in{"Rectangle [1,2] 10 20\nSquare [3,4] 5\nRectangle [5,6] 10 20\nSquare [7,8] 5\n"};
+    Shapes::GeometryPool pool;
+
+    const auto shapes = Shapes::load_shapes(in, pool);
+
+    REQUIRE(shapes.size() == 4);
+    CHECK(pool.size() == 2);
+    CHECK(&shapes[0].geometry() == &shapes[2].geometry());
+    CHECK(&shapes[1].geometry() == &shapes[3].geometry());
+    CHECK(shapes[1].geometry() == Shapes::ShapeGeometry{Shapes::ShapeKind::square, 5, 5});
+    CHECK(shapes[3].coord().x == 7);
+    CHECK(shapes[3].coord().y == 8);
+
+    SECTION("shapes are drawn as the kind they were loaded as")
+    {
+        CHECK(drawn(shapes[0]) == drawn(Shapes::Rectangle{1, 2, 10, 20}));
+        CHECK(drawn(shapes[1]) == drawn(Shapes::Square{3, 4, 5}));
+    }
+}
+
+TEST_CASE("load_shapes - errors")
+{
+    Shapes::GeometryPool pool;
+
+    SECTION("unknown shape")
+    {
+        std::istringstream in{"Square [0,0] 5\nCircle [0,0] 5\n"};
+        CHECK_THROWS_AS(Shapes::load_shapes(in, pool), std::runtime_error);
+    }
+
+    SECTION("malformed shape")
+    {
+        std::istringstream in{"Rectangle [0,0] 5 wide\n"};
+        CHECK_THROWS_AS(Shapes::load_shapes(in, pool), std::runtime_error);
+    }
+
+    SECTION("truncated stream")
+    {
+        std::istringstream in{"Square [0,0]"};
+        CHECK_THROWS_AS(Shapes::load_shapes(in, pool), std::runtime_error);
+    }
+}
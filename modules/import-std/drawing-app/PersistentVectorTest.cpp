@@ -0,0 +1,212 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import PersistentVector;
+
+namespace
+{
+    // 32 - first leaf, 1024 - trie of depth 1 is full, 1056 - root overflow (32 leaves + tail),
+    // 32800 - trie of depth 2 is full
+    constexpr std::size_t boundaries[] = {0, 1, 31, 32, 33, 63, 64, 65, 1023, 1024, 1025, 1055, 1056, 1057, 1088, 1089, 32'799, 32'800, 32'801, 32'832, 32'833};
+
+    PersistentVector<int> iota_vector(std::size_t size)
+    {
+        PersistentVector<int> vec;
+        for (std::size_t i = 0; i < size; ++i)
+            vec = vec.push_back(static_cast<int>(i));
+        return vec;
+    }
+
+    bool equals(const PersistentVector<int>& vec, const std::vector<int>& expected)
+    {
+        if (vec.size() != expected.size())
+            return false;
+
+        for (std::size_t i = 0; i < expected.size(); ++i)
+            if (vec[i] != expected[i])
+                return false;
+
+        return std::vector<int>(vec.begin(), vec.end()) == expected;
+    }
+
+    std::vector<int> iota_std_vector(std::size_t size)
+    {
+        std::vector<int> vec(size);
+        for (std::size_t i = 0; i < size; ++i)
+            vec[i] = static_cast<int>(i);
+        return vec;
+    }
+} // namespace
+
+TEST_CASE("persistent vector - push_back")
+{
+    PersistentVector<int> vec;
+    std::vector<int> expected;
+
+    for (std::size_t size : boundaries)
+    {
+        while (expected.size() < size)
+        {
+            vec = vec.push_back(static_cast<int>(expected.size()));
+            expected.push_back(static_cast<int>(expected.size()));
+        }
+
+        INFO("size: " << size);
+        CHECK(equals(vec, expected));
+    }
+}
+
+TEST_CASE("persistent vector - set")
+{
+    const auto original = iota_vector(32'833);
+
+    for (std::size_t index : boundaries)
+    {
+        if (index >= original.size())
+            continue;
+
+        INFO("index: " << index);
+
+        const auto modified = original.set(index, -1);
+
+        auto expected = iota_std_vector(original.size());
+        expected[index] = -1;
+        CHECK(modified[index] == -1);
+        CHECK(equals(modified, expected));
+        CHECK(original[index] == static_cast<int>(index)); // untouched
+    }
+
+    CHECK_THROWS_AS(original.set(original.size(), 0), std::out_of_range);
+}
+
+TEST_CASE("persistent vector - pop_back")
+{
+    SECTION("every step down from a trie of depth 2")
+    {
+        auto vec = iota_vector(1'100);
+        auto expected = iota_std_vector(1'100);
+
+        while (!expected.empty())
+        {
+            vec = vec.pop_back();
+            expected.pop_back();
+
+            INFO("size: " << expected.size());
+            REQUIRE(equals(vec, expected));
+        }
+
+        CHECK_THROWS_AS(vec.pop_back(), std::out_of_range);
+    }
+
+    SECTION("across boundaries of a trie of depth 3")
+    {
+        auto vec = iota_vector(32'833);
+
+        for (std::size_t size = 32'833; size > 1'000; --size)
+        {
+            vec = vec.pop_back();
+
+            if (vec.size() == 32'800 || vec.size() == 32'799 || vec.size() == 1'056 || vec.size() == 1'055)
+                CHECK(equals(vec, iota_std_vector(vec.size())));
+        }
+    }
+
+    SECTION("push_back after pop_back")
+    {
+        for (std::size_t size : boundaries)
+        {
+            if (size == 0)
+                continue;
+
+            auto vec = iota_vector(size).pop_back().push_back(-1);
+            auto expected = iota_std_vector(size);
+            expected.back() = -1;
+
+            INFO("size: " << size);
+            CHECK(equals(vec, expected));
+        }
+    }
+}
+
+TEST_CASE("persistent vector - erase")
+{
+    const auto original = iota_vector(100);
+    auto expected = iota_std_vector(100);
+    expected.erase(expected.begin() + 40);
+
+    CHECK(equals(original.erase(40), expected));
+    CHECK(equals(original, iota_std_vector(100)));
+}
+
+namespace
+{
+    struct CopyCounted
+    {
+        inline static std::size_t copies = 0;
+
+        int value;
+
+        CopyCounted(int value)
+            : value{value}
+        { }
+
+        CopyCounted(const CopyCounted& other)
+            : value{other.value}
+        {
+            ++copies;
+        }
+
+        CopyCounted& operator=(const CopyCounted& other)
+        {
+            value = other.value;
+            ++copies;
+            return *this;
+        }
+    };
+} // namespace
+
+TEST_CASE("persistent vector - cost of erase grows with the number of elements after the erased one")
+{
+    constexpr std::size_t size = 1'000;
+
+    PersistentVector<CopyCounted> vec;
+    for (std::size_t i = 0; i < size; ++i)
+        vec = vec.push_back(CopyCounted{static_cast<int>(i)});
+
+    CopyCounted::copies = 0;
+    const auto without_last = vec.erase(size - 1);
+    CHECK(CopyCounted::copies < 32); // only the tail is copied
+    CHECK(without_last.size() == size - 1);
+
+    CopyCounted::copies = 0;
+    const auto without_first = vec.erase(0);
+    CHECK(CopyCounted::copies >= size - 1); // every following element is re-appended
+    CHECK(without_first.size() == size - 1);
+    CHECK(without_first.front().value == 1);
+}
+
+TEST_CASE("persistent vector - versions are isolated")
+{
+    const auto v1 = iota_vector(1'057);
+    const auto v2 = v1.push_back(1'057);
+    const auto v3 = v1.set(10, -10).set(1'056, -1'056);
+    const auto v4 = v1.pop_back().pop_back();
+
+    CHECK(equals(v1, iota_std_vector(1'057)));
+    CHECK(equals(v2, iota_std_vector(1'058)));
+    CHECK(v3[10] == -10);
+    CHECK(v3[1'056] == -1'056);
+    CHECK(v3[11] == 11);
+    CHECK(equals(v4, iota_std_vector(1'055)));
+
+    SECTION("non-trivial values")
+    {
+        const auto s1 = PersistentVector<std::string>{}.push_back("a").push_back("b");
+        const auto s2 = s1.update(0, [](std::string& s) { s += "!"; });
+
+        CHECK(s1[0] == "a");
+        CHECK(s2[0] == "a!");
+        CHECK(s2[1] == "b");
+    }
+}
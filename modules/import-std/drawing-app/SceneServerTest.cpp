@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+import std;
+
+import Shapes;
+
+using namespace std::literals;
+
+namespace
+{
+    std::string test_socket_path()
+    {
+        return "/tmp/drawing_app_scene_test_" + std::to_string(::getpid()) + ".sock";
+    }
+
+    Shapes::ShapeFactory& shape_factory()
+    {
+        Shapes::ShapeFactory& factory = Shapes::SingletonShapeFactory::instance();
+        factory.register_creator(Shapes::Rectangle::id, [] { return std::make_unique<Shapes::Rectangle>(); });
+        factory.register_creator(Shapes::Square::id, [] { return std::make_unique<Shapes::Square>(); });
+        return factory;
+    }
+
+    std::vector<Shapes::ShapeState> to_vector(std::span<const Shapes::ShapeState> delta)
+    {
+        return {delta.begin(), delta.end()};
+    }
+
+    template <typename Predicate>
+    bool wait_for(Predicate predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+                return false;
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+} // namespace
+
+TEST_CASE("scene server - batches are answered with deltas")
+{
+    using enum Shapes::CommandType;
+
+    const auto socket_path = test_socket_path();
+    Shapes::SceneServer server{shape_factory(), socket_path};
+    server.start();
+    Shapes::SceneClient client{socket_path};
+
+    const Shapes::Command create[] = {{create_rectangle, 0, 10, 20, 30, 40}, {create_square, 0, 1, 2, 5, 0}};
+    CHECK(to_vector(client.apply(create)) == std::vector<Shapes::ShapeState>{{0, 10, 20, 30, 40}, {1, 1, 2, 5, 5}});
+    CHECK(server.shape_count() == 2);
+
+    SECTION("a shape touched several times is sent once with its final state")
+    {
+        const Shapes::Command batch[] = {{move, 1, 5, 5, 0, 0}, {move, 0, -10, 0, 0, 0}, {move, 1, 1, 1, 0, 0}, {resize, 1, 0, 0, 7, 0}};
+
+        CHECK(to_vector(client.apply(batch)) == std::vector<Shapes::ShapeState>{{0, 0, 20, 30, 40}, {1, 7, 8, 7, 7}});
+    }
+
+    SECTION("commands for unknown shapes are ignored")
+    {
+        const Shapes::Command batch[] = {{move, 2, 1, 1, 0, 0}, {resize, 1'000, 0, 0, 1, 1}};
+
+        CHECK(client.apply(batch).empty());
+        CHECK(server.shape_count() == 2);
+    }
+
+    SECTION("empty batch")
+    {
+        CHECK(client.apply({}).empty());
+    }
+}
+
+TEST_CASE("scene server - client sending an oversized batch is disconnected")
+{
+    const auto socket_path = test_socket_path();
+    Shapes::SceneServer server{shape_factory(), socket_path};
+    server.start();
+
+    // only the frame header - the server must not allocate for the announced commands
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socket_path.c_str());
+    REQUIRE(::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+
+    const std::uint32_t count = Shapes::SceneServer::max_batch_size + 1;
+    REQUIRE(::write(fd, &count, sizeof(count)) == sizeof(count));
+
+    char byte;
+    CHECK(::read(fd, &byte, 1) == 0); // closed by the server
+    ::close(fd);
+
+    // other clients are served
+    Shapes::SceneClient client{socket_path};
+    const Shapes::Command create[] = {{Shapes::CommandType::create_square, 0, 0, 0, 1, 1}};
+    CHECK(client.apply(create).size() == 1);
+}
+
+TEST_CASE("scene server - client disconnecting before reading its delta does not stop the server")
+{
+    const auto socket_path = test_socket_path();
+    Shapes::SceneServer server{shape_factory(), socket_path};
+    server.start();
+
+    // the batch stays readable by the server after the client has closed - the server writes the delta to a closed socket
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, socket_path.c_str());
+    REQUIRE(::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+
+    const std::uint32_t count = 1;
+    const Shapes::Command create{Shapes::CommandType::create_square, 0, 0, 0, 1, 1};
+    REQUIRE(::write(fd, &count, sizeof(count)) == sizeof(count));
+    REQUIRE(::write(fd, &create, sizeof(create)) == sizeof(create));
+    ::close(fd);
+
+    CHECK(wait_for([&] { return server.shape_count() == 1 && server.client_count() == 0; }));
+
+    Shapes::SceneClient client{socket_path};
+    CHECK(client.apply({}).empty());
+}
+
+TEST_CASE("scene server - sessions of disconnected clients are removed")
+{
+    const auto socket_path = test_socket_path();
+    Shapes::SceneServer server{shape_factory(), socket_path};
+    server.start();
+
+    for (int i = 0; i < 20; ++i)
+    {
+        Shapes::SceneClient client{socket_path};
+        CHECK(client.apply({}).empty());
+    }
+
+    CHECK(wait_for([&] { return server.client_count() == 0; }));
+
+    Shapes::SceneClient client{socket_path};
+    CHECK(client.apply({}).empty());
+    CHECK(server.client_count() == 1);
+}
@@ -0,0 +1,95 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import Shapes;
+
+namespace
+{
+    int x_of(const Shapes::ShapeValue& shape)
+    {
+        return std::visit([](const auto& shp) { return shp.coord().x; }, shape);
+    }
+
+    Shapes::Scene move_all(const Shapes::Scene& scene, int dx)
+    {
+        auto result = scene;
+        for (std::size_t i = 0; i < scene.size(); ++i)
+            result = result.move(i, dx, 0);
+        return result;
+    }
+} // namespace
+
+TEST_CASE("scene - edits return new versions")
+{
+    const auto empty = Shapes::Scene{};
+    const auto one = empty.add(Shapes::Rectangle{10, 20, 30, 40});
+    const auto two = one.add(Shapes::Square{1, 2, 3});
+    const auto moved = two.move(0, 5, 0);
+    const auto removed = moved.remove(0);
+
+    CHECK(empty.size() == 0);
+    CHECK(one.size() == 1);
+    CHECK(x_of(two[0]) == 10);
+    CHECK(x_of(moved[0]) == 15);
+    CHECK(removed.size() == 1);
+    CHECK(std::holds_alternative<Shapes::Square>(removed[0]));
+}
+
+TEST_CASE("scene store - snapshots are isolated from later edits")
+{
+    Shapes::SceneStore store;
+    store.edit([](const Shapes::Scene& scene) { return scene.add(Shapes::Rectangle{0, 0, 1, 1}); });
+
+    const auto pinned = store.snapshot();
+    store.edit([](const Shapes::Scene& scene) { return move_all(scene, 7); });
+    store.publish(Shapes::Scene{});
+
+    CHECK(pinned->size() == 1);
+    CHECK(x_of((*pinned)[0]) == 0);
+    CHECK(store.snapshot()->size() == 0);
+}
+
+TEST_CASE("scene store - readers see consistent versions during edits")
+{
+    constexpr int shape_count = 50;
+    constexpr int edit_count = 2'000;
+
+    Shapes::SceneStore store;
+    store.edit([](const Shapes::Scene& scene) {
+        auto result = scene;
+        for (int i = 0; i < shape_count; ++i)
+            result = result.add(Shapes::Rectangle{0, i, 1, 1});
+        return result;
+    });
+
+    std::atomic<bool> done{false};
+    std::atomic<int> inconsistent{0};
+
+    // every edit moves all shapes - within a version all shapes have the same x
+    std::vector<std::jthread> readers;
+    for (int i = 0; i < 4; ++i)
+        readers.emplace_back([&] {
+            int last_x = 0;
+            while (!done)
+            {
+                const auto scene = store.snapshot();
+                const int x = x_of((*scene)[0]);
+                for (const auto& shape : *scene)
+                    if (x_of(shape) != x)
+                        ++inconsistent;
+                if (x < last_x) // versions are published in order
+                    ++inconsistent;
+                last_x = x;
+            }
+        });
+
+    for (int i = 0; i < edit_count; ++i)
+        store.edit([](const Shapes::Scene& scene) { return move_all(scene, 1); });
+
+    done = true;
+    readers.clear();
+
+    CHECK(inconsistent == 0);
+    CHECK(x_of((*store.snapshot())[shape_count - 1]) == edit_count);
+}
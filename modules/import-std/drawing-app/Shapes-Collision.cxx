@@ -0,0 +1,256 @@
+export module Shapes:Collision;
+
+import std;
+
+import :Rectangle;
+import :Square;
+import :Flyweight;
+
+export namespace Shapes
+{
+    struct BoundingBox
+    {
+        int left, top, right, bottom;
+
+        bool overlaps(const BoundingBox& other) const noexcept
+        {
+            return left < other.right && other.left < right && top < other.bottom && other.top < bottom;
+        }
+    };
+
+    BoundingBox bounding_box(const Rectangle& rect);
+
+    BoundingBox bounding_box(const Square& square);
+
+    BoundingBox bounding_box(const FlyweightShape& shape);
+
+    struct OverlapPair
+    {
+        std::uint32_t first, second; // indices of boxes, first < second
+
+        bool operator==(const OverlapPair&) const = default;
+    };
+
+    // Sweep-and-prune broad phase: boxes are radix sorted by their left edge,
+    // then the sorted sequence is split into chunks swept by separate threads.
+    // Buffers and worker threads are kept between calls - reuse one instance per frame.
+    // Workers are started by the first call with enough boxes to need them.
+    class BroadPhase
+    {
+        struct Endpoint
+        {
+            std::uint32_t key;
+            std::uint32_t index;
+        };
+
+        // current call - worker i sweeps chunk i, chunk 0 is swept by the calling thread
+        struct Pass
+        {
+            std::span<const BoundingBox> boxes;
+            std::size_t chunk_size = 0;
+            std::size_t chunk_count = 0;
+        };
+
+        unsigned thread_count_;
+        std::vector<Endpoint> endpoints_;
+        std::vector<Endpoint> scratch_;
+        std::vector<std::vector<OverlapPair>> thread_pairs_;
+
+        std::mutex mtx_;
+        std::condition_variable_any pass_started_;
+        std::condition_variable pass_finished_;
+        Pass pass_;                    // guarded by mtx_
+        std::uint64_t generation_ = 0; // guarded by mtx_, incremented for every pass
+        std::size_t running_ = 0;      // guarded by mtx_
+        std::exception_ptr error_;     // guarded by mtx_
+        std::vector<std::jthread> workers_; // last - stopped and joined before other members are destroyed
+
+        static constexpr std::size_t min_boxes_per_thread = 4096;
+
+        void sort_endpoints(std::span<const BoundingBox> boxes);
+
+        void sweep(std::span<const BoundingBox> boxes, std::size_t first, std::size_t last, std::vector<OverlapPair>& pairs) const;
+
+        void sweep_chunk(const Pass& pass, std::size_t chunk);
+
+        void run_worker(std::stop_token stop, std::size_t chunk, std::uint64_t generation);
+
+    public:
+        explicit BroadPhase(unsigned thread_count = std::max(1u, std::thread::hardware_concurrency()));
+
+        BroadPhase(const BroadPhase&) = delete;
+        BroadPhase& operator=(const BroadPhase&) = delete;
+
+        // Replaces the content of `output` with all pairs of overlapping boxes
+        void find_overlaps(std::span<const BoundingBox> boxes, std::vector<OverlapPair>& output);
+    };
+} // namespace Shapes
+
+namespace Shapes
+{
+    BoundingBox bounding_box(const Rectangle& rect)
+    {
+        const auto pt = rect.coord();
+        return BoundingBox{pt.x, pt.y, pt.x + rect.width(), pt.y + rect.height()};
+    }
+
+    BoundingBox bounding_box(const Square& square)
+    {
+        const auto pt = square.coord();
+        return BoundingBox{pt.x, pt.y, pt.x + square.size(), pt.y + square.size()};
+    }
+
+    BoundingBox bounding_box(const FlyweightShape& shape)
+    {
+        const auto pt = shape.coord();
+        return BoundingBox{pt.x, pt.y, pt.x + shape.geometry().width, pt.y + shape.geometry().height};
+    }
+
+    BroadPhase::BroadPhase(unsigned thread_count)
+        : thread_count_{std::max(1u, thread_count)}
+        , thread_pairs_(thread_count_)
+    { }
+
+    void BroadPhase::sort_endpoints(std::span<const BoundingBox> boxes)
+    {
+        endpoints_.resize(boxes.size());
+        scratch_.resize(boxes.size());
+
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+        {
+            // flipping the sign bit maps int ordering onto unsigned ordering
+            const auto key = static_cast<std::uint32_t>(boxes[i].left) ^ 0x8000'0000u;
+            endpoints_[i] = Endpoint{key, static_cast<std::uint32_t>(i)};
+        }
+
+        // LSD radix sort - 4 stable passes, 8 bits each
+        for (unsigned shift = 0; shift < 32; shift += 8)
+        {
+            std::array<std::size_t, 256> offsets{};
+            for (const auto& ep : endpoints_)
+                ++offsets[(ep.key >> shift) & 0xFF];
+
+            std::size_t total = 0;
+            for (auto& offset : offsets)
+                total += std::exchange(offset, total);
+
+            for (const auto& ep : endpoints_)
+                scratch_[offsets[(ep.key >> shift) & 0xFF]++] = ep;
+
+            endpoints_.swap(scratch_);
+        }
+    }
+
+    void BroadPhase::sweep(std::span<const BoundingBox> boxes, std::size_t first, std::size_t last, std::vector<OverlapPair>& pairs) const
+    {
+        pairs.clear();
+
+        for (std::size_t i = first; i < last; ++i)
+        {
+            const auto& box = boxes[endpoints_[i].index];
+
+            for (std::size_t j = i + 1; j < endpoints_.size(); ++j)
+            {
+                const auto& candidate = boxes[endpoints_[j].index];
+                if (candidate.left >= box.right)
+                    break;
+
+                if (box.overlaps(candidate))
+                {
+                    const auto [a, b] = std::minmax(endpoints_[i].index, endpoints_[j].index);
+                    pairs.push_back(OverlapPair{a, b});
+                }
+            }
+        }
+    }
+
+    void BroadPhase::sweep_chunk(const Pass& pass, std::size_t chunk)
+    {
+        const std::size_t first = chunk * pass.chunk_size;
+        const std::size_t last = std::min(first + pass.chunk_size, pass.boxes.size());
+        sweep(pass.boxes, first, last, thread_pairs_[chunk]);
+    }
+
+    void BroadPhase::run_worker(std::stop_token stop, std::size_t chunk, std::uint64_t generation)
+    {
+        for (;;)
+        {
+            Pass pass;
+            {
+                std::unique_lock lk{mtx_};
+                if (!pass_started_.wait(lk, stop, [&] { return generation_ != generation; }))
+                    return;
+                generation = generation_;
+                pass = pass_;
+            }
+
+            if (chunk >= pass.chunk_count)
+                continue;
+
+            std::exception_ptr error;
+            try
+            {
+                sweep_chunk(pass, chunk);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            std::lock_guard lk{mtx_};
+            if (error && !error_)
+                error_ = error;
+            if (--running_ == 0)
+                pass_finished_.notify_one();
+        }
+    }
+
+    void BroadPhase::find_overlaps(std::span<const BoundingBox> boxes, std::vector<OverlapPair>& output)
+    {
+        output.clear();
+        sort_endpoints(boxes);
+
+        const std::size_t chunk_count = std::clamp<std::size_t>(boxes.size() / min_boxes_per_thread, 1, thread_count_);
+        const Pass pass{boxes, (boxes.size() + chunk_count - 1) / chunk_count, chunk_count};
+
+        if (chunk_count > 1)
+        {
+            // only this thread increments generation_ - new workers wait for the next pass
+            for (std::size_t chunk = workers_.size() + 1; chunk < chunk_count; ++chunk)
+                workers_.emplace_back([this, chunk, generation = generation_](std::stop_token stop) { run_worker(stop, chunk, generation); });
+
+            {
+                std::lock_guard lk{mtx_};
+                pass_ = pass;
+                running_ = chunk_count - 1;
+                ++generation_;
+            }
+            pass_started_.notify_all();
+        }
+
+        std::exception_ptr error;
+        try
+        {
+            sweep_chunk(pass, 0);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        if (chunk_count > 1)
+        {
+            std::unique_lock lk{mtx_};
+            pass_finished_.wait(lk, [this] { return running_ == 0; });
+            if (!error)
+                error = error_;
+            error_ = nullptr;
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+
+        for (std::size_t chunk = 0; chunk < chunk_count; ++chunk)
+            output.insert(output.end(), thread_pairs_[chunk].begin(), thread_pairs_[chunk].end());
+    }
+} // namespace Shapes
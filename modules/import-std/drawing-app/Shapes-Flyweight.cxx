@@ -0,0 +1,147 @@
+export module Shapes:Flyweight;
+
+import std;
+
+import :Point;
+import :Rectangle;
+import :Square;
+
+export namespace Shapes
+{
+    enum class ShapeKind
+    {
+        rectangle,
+        square
+    };
+
+    // Intrinsic state shared by all instances with the same geometry
+    struct ShapeGeometry
+    {
+        ShapeKind kind;
+        int width;
+        int height;
+
+        bool operator==(const ShapeGeometry&) const = default;
+    };
+
+    struct ShapeGeometryHash
+    {
+        std::size_t operator()(const ShapeGeometry& geometry) const noexcept;
+    };
+
+    // Hash-consing table - equal geometries are stored once and have stable addresses
+    class GeometryPool
+    {
+        std::unordered_set<ShapeGeometry, ShapeGeometryHash> geometries_;
+
+    public:
+        const ShapeGeometry& intern(const ShapeGeometry& geometry)
+        {
+            return *geometries_.insert(geometry).first;
+        }
+
+        std::size_t size() const noexcept
+        {
+            return geometries_.size();
+        }
+
+        // approximate: elements, node links and bucket array
+        std::size_t memory_usage() const noexcept
+        {
+            return geometries_.size() * (sizeof(ShapeGeometry) + 2 * sizeof(void*))
+                + geometries_.bucket_count() * sizeof(void*);
+        }
+    };
+
+    // Extrinsic state (position) + pointer to shared geometry; no vptr, no own heap allocation
+    class FlyweightShape
+    {
+        Point coord_;
+        const ShapeGeometry* geometry_;
+
+    public:
+        FlyweightShape(const Point& coord, const ShapeGeometry& geometry)
+            : coord_{coord}
+            , geometry_{&geometry}
+        { }
+
+        Point coord() const
+        {
+            return coord_;
+        }
+
+        const ShapeGeometry& geometry() const
+        {
+            return *geometry_;
+        }
+
+        void move(int dx, int dy)
+        {
+            coord_.translate(dx, dy);
+        }
+
+        void draw() const;
+    };
+
+    // Reads shapes in format "Rectangle [x,y] w h" or "Square [x,y] size";
+    // geometries are deduplicated in the pool while loading
+    std::vector<FlyweightShape> load_shapes(std::istream& in, GeometryPool& pool);
+} // namespace Shapes
+
+namespace Shapes
+{
+    std::size_t ShapeGeometryHash::operator()(const ShapeGeometry& geometry) const noexcept
+    {
+        std::size_t seed = std::hash<int>{}(static_cast<int>(geometry.kind));
+        for (int value : {geometry.width, geometry.height})
+            seed ^= std::hash<int>{}(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+
+        return seed;
+    }
+
+    void FlyweightShape::draw() const
+    {
+        switch (geometry_->kind)
+        {
+        case ShapeKind::rectangle:
+            Rectangle{coord_.x, coord_.y, geometry_->width, geometry_->height}.draw();
+            break;
+        case ShapeKind::square:
+            Square{coord_.x, coord_.y, geometry_->width}.draw();
+            break;
+        }
+    }
+
+    std::vector<FlyweightShape> load_shapes(std::istream& in, GeometryPool& pool)
+    {
+        std::vector<FlyweightShape> shapes;
+        std::string kind;
+
+        while (in >> kind)
+        {
+            Point coord;
+            ShapeGeometry geometry{};
+
+            if (kind == Rectangle::id)
+            {
+                geometry.kind = ShapeKind::rectangle;
+                in >> coord >> geometry.width >> geometry.height;
+            }
+            else if (kind == Square::id)
+            {
+                geometry.kind = ShapeKind::square;
+                in >> coord >> geometry.width;
+                geometry.height = geometry.width;
+            }
+            else
+                throw std::runtime_error("Unknown shape: " + kind);
+
+            if (!in)
+                throw std::runtime_error("Stream reading error");
+
+            shapes.emplace_back(coord, pool.intern(geometry));
+        }
+
+        return shapes;
+    }
+} // namespace Shapes
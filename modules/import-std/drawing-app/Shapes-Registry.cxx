@@ -0,0 +1,33 @@
+export module Shapes:Registry;
+
+import std;
+
+import SlotMap;
+import :Scene;
+
+export namespace Shapes
+{
+    using ShapeHandle = SlotMapHandle;
+
+    // Owns shapes by value in contiguous storage - handles detect removed shapes
+    using ShapeRegistry = SlotMap<ShapeValue>;
+
+    void draw_all(const ShapeRegistry& registry);
+
+    void move_all(ShapeRegistry& registry, int dx, int dy);
+} // namespace Shapes
+
+namespace Shapes
+{
+    void draw_all(const ShapeRegistry& registry)
+    {
+        for (const auto& shape : registry)
+            std::visit([](const auto& shp) { shp.draw(); }, shape);
+    }
+
+    void move_all(ShapeRegistry& registry, int dx, int dy)
+    {
+        for (auto& shape : registry)
+            std::visit([dx, dy](auto& shp) { shp.move(dx, dy); }, shape);
+    }
+} // namespace Shapes
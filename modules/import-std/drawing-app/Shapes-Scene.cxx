@@ -0,0 +1,195 @@
+export module Shapes:Scene;
+
+import std;
+
+import PersistentVector;
+import :Rectangle;
+import :Square;
+
+export namespace Shapes
+{
+    using ShapeValue = std::variant<Rectangle, Square>;
+
+    // Immutable snapshot of a scene - shapes are held by value and shared between versions
+    class Scene
+    {
+        PersistentVector<ShapeValue> shapes_;
+
+        explicit Scene(PersistentVector<ShapeValue> shapes);
+
+    public:
+        using const_iterator = PersistentVector<ShapeValue>::const_iterator;
+
+        Scene() = default;
+
+        std::size_t size() const noexcept
+        {
+            return shapes_.size();
+        }
+
+        const ShapeValue& operator[](std::size_t index) const
+        {
+            return shapes_[index];
+        }
+
+        const_iterator begin() const
+        {
+            return shapes_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return shapes_.end();
+        }
+
+        [[nodiscard]] Scene add(ShapeValue shape) const;
+
+        [[nodiscard]] Scene replace(std::size_t index, ShapeValue shape) const;
+
+        [[nodiscard]] Scene move(std::size_t index, int dx, int dy) const;
+
+        // Linear in the number of shapes after index - they are re-appended to the new version.
+        // Removing the last shape is O(log n).
+        [[nodiscard]] Scene remove(std::size_t index) const;
+
+        void draw() const;
+    };
+
+    // Publication point for scene snapshots: readers pin the current version without locks,
+    // editors swap in a new version under the editor lock.
+    // std::atomic<std::shared_ptr> is not lock-free in libstdc++ (load() takes a lock shared with the
+    // writer), so the current version is published as a raw pointer protected by hazard pointers:
+    //  - a reader announces the version in a hazard slot, checks it is still current and copies its
+    //    shared_ptr (an atomic increment)
+    //  - the editor retires replaced versions and deletes only those not announced by any reader
+    // There are hazard_slot_count slots - snapshot() is lock-free for up to that many concurrent
+    // readers, any reader beyond that spins until one of the slots is released.
+    class SceneStore
+    {
+        struct Version
+        {
+            std::shared_ptr<const Scene> scene;
+        };
+
+        static constexpr std::size_t hazard_slot_count = 64;
+
+        static_assert(std::atomic<Version*>::is_always_lock_free);
+
+        std::atomic<Version*> current_{new Version{std::make_shared<const Scene>()}};
+        mutable std::array<std::atomic<Version*>, hazard_slot_count> hazards_{};
+
+        std::mutex editor_mtx_;
+        std::vector<Version*> retired_; // guarded by editor_mtx_
+
+        void replace(std::shared_ptr<const Scene> scene);
+
+    public:
+        SceneStore() = default;
+
+        SceneStore(const SceneStore&) = delete;
+        SceneStore& operator=(const SceneStore&) = delete;
+
+        ~SceneStore();
+
+        std::shared_ptr<const Scene> snapshot() const noexcept;
+
+        void publish(Scene scene);
+
+        template <typename F>
+        std::shared_ptr<const Scene> edit(F&& edit_fn)
+        {
+            std::lock_guard lk{editor_mtx_};
+            auto scene = std::make_shared<const Scene>(edit_fn(*current_.load()->scene));
+            replace(scene);
+            return scene;
+        }
+    };
+} // namespace Shapes
+
+namespace Shapes
+{
+    Scene::Scene(PersistentVector<ShapeValue> shapes)
+        : shapes_{std::move(shapes)}
+    { }
+
+    Scene Scene::add(ShapeValue shape) const
+    {
+        return Scene{shapes_.push_back(std::move(shape))};
+    }
+
+    Scene Scene::replace(std::size_t index, ShapeValue shape) const
+    {
+        return Scene{shapes_.set(index, std::move(shape))};
+    }
+
+    Scene Scene::move(std::size_t index, int dx, int dy) const
+    {
+        return Scene{shapes_.update(index, [dx, dy](ShapeValue& shape) {
+            std::visit([dx, dy](auto& shp) { shp.move(dx, dy); }, shape);
+        })};
+    }
+
+    Scene Scene::remove(std::size_t index) const
+    {
+        return Scene{shapes_.erase(index)};
+    }
+
+    void Scene::draw() const
+    {
+        for (const auto& shape : shapes_)
+            std::visit([](const auto& shp) { shp.draw(); }, shape);
+    }
+
+    SceneStore::~SceneStore()
+    {
+        delete current_.load();
+        for (auto* version : retired_)
+            delete version;
+    }
+
+    std::shared_ptr<const Scene> SceneStore::snapshot() const noexcept
+    {
+        // threads start looking for a free slot at different positions
+        static thread_local const std::size_t first_slot = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+        for (std::size_t i = first_slot;; ++i)
+        {
+            auto& slot = hazards_[i % hazard_slot_count];
+
+            auto* version = current_.load();
+            Version* expected = nullptr;
+            if (!slot.compare_exchange_strong(expected, version))
+                continue; // used by another reader
+
+            // the version can't be deleted once it is announced while still current
+            for (auto* latest = current_.load(); latest != version; latest = current_.load())
+            {
+                version = latest;
+                slot.store(version);
+            }
+
+            auto scene = version->scene;
+            slot.store(nullptr, std::memory_order_release);
+            return scene;
+        }
+    }
+
+    void SceneStore::publish(Scene scene)
+    {
+        std::lock_guard lk{editor_mtx_};
+        replace(std::make_shared<const Scene>(std::move(scene)));
+    }
+
+    // editor_mtx_ has to be locked
+    void SceneStore::replace(std::shared_ptr<const Scene> scene)
+    {
+        retired_.push_back(current_.exchange(new Version{std::move(scene)}));
+
+        std::erase_if(retired_, [this](Version* version) {
+            if (std::ranges::any_of(hazards_, [version](const auto& slot) { return slot.load() == version; }))
+                return false;
+            delete version;
+            return true;
+        });
+    }
+} // namespace Shapes
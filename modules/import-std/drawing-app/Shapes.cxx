@@ -4,4 +4,9 @@ export import :Point;
 export import :Base;
 export import :Factory;
 export import :Rectangle;
-export import :Square;
\ No newline at end of file
+export import :Square;
+export import :Scene;
+export import :Flyweight;
+export import :Collision;
+export import :Server;
+export import :Registry;
\ No newline at end of file
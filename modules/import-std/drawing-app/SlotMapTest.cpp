@@ -0,0 +1,67 @@
+#include <catch2/catch_test_macros.hpp>
+
+import std;
+
+import SlotMap;
+
+namespace
+{
+    struct ThrowingValue
+    {
+        std::string text;
+
+        explicit ThrowingValue(std::string value)
+            : text{std::move(value)}
+        {
+            if (text == "throw")
+                throw std::runtime_error("construction failed");
+        }
+    };
+} // namespace
+
+TEST_CASE("slot map - handles")
+{
+    SlotMap<std::string> map;
+    const auto a = map.insert("a");
+    const auto b = map.insert("b");
+    const auto c = map.insert("c");
+
+    CHECK(map.erase(a));
+    CHECK_FALSE(map.erase(a));
+    CHECK(map.find(a) == nullptr);
+    CHECK(map.at(b) == "b");
+    CHECK(map.at(c) == "c"); // moved into the hole
+
+    const auto d = map.insert("d"); // reuses the slot of a with a new generation
+    CHECK(d.index == a.index);
+    CHECK_FALSE(map.contains(a));
+    CHECK(map.at(d) == "d");
+    CHECK(map.size() == 3);
+    CHECK_THROWS_AS(map.at(SlotMapHandle{}), std::out_of_range);
+}
+
+TEST_CASE("slot map - emplace is exception safe")
+{
+    SlotMap<ThrowingValue> map;
+    const auto a = map.emplace("a");
+    const auto b = map.emplace("b");
+    map.erase(a);
+
+    // a free slot is available - it must not be lost
+    CHECK_THROWS_AS(map.emplace("throw"), std::runtime_error);
+    CHECK(map.size() == 1);
+    CHECK(map.at(b).text == "b");
+
+    const auto c = map.emplace("c");
+    CHECK(c.index == a.index);
+
+    // no free slot - no orphan slot or value is left behind
+    CHECK_THROWS_AS(map.emplace("throw"), std::runtime_error);
+    CHECK(map.size() == 2);
+
+    const auto d = map.emplace("d");
+    CHECK(d.index == 2);
+    CHECK(map.handle_at(2) == d);
+    CHECK(map.at(c).text == "c");
+    CHECK(map.at(d).text == "d");
+}